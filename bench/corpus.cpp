@@ -0,0 +1,137 @@
+/*
+ * OBS Source Search Plugin
+ * Copyright (C) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ */
+
+#include "corpus.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <random>
+
+namespace {
+
+const char *const kPrefixes[] = {"Booth", "Stage", "Main", "Wide", "Close", "Guest", "Host", "Studio",
+				 "Desk", "Remote", "Backup", "Left", "Right", "Top"};
+const char *const kNouns[] = {"Camera", "Mic", "Browser", "Overlay", "Lower Third", "Background",
+			      "Logo", "Chat", "Alerts", "Timer", "Scoreboard", "Webcam", "Capture",
+			      "Ticker", "Frame", "Music", "Intro Video", "Countdown"};
+const char *const kScenePrefixes[] = {"Intro", "Gameplay", "Interview", "BRB", "Outro", "Panel",
+				      "Desk", "Highlights", "Sponsor", "Break", "Replay", "Starting Soon"};
+const char *const kFilterNames[] = {"Color Correction", "Chroma Key", "Noise Suppression", "Compressor",
+				    "Crop/Pad", "Sharpen", "Limiter", "Image Mask/Blend", "Scroll", "Gain"};
+
+struct SourceType {
+	const char *id;
+	unsigned weight;
+};
+const SourceType kSourceTypes[] = {
+	{"image_source", 20},  {"browser_source", 18},  {"ffmpeg_source", 14}, {"text_ft2_source_v2", 12},
+	{"color_source_v3", 8}, {"dshow_input", 6},     {"window_capture", 5}, {"game_capture", 4},
+	{"wasapi_input_capture", 5}, {"ndi_source", 4}, {"slideshow", 2},      {"monitor_capture", 2},
+};
+const char *const kFilterTypes[] = {"color_filter_v2", "chroma_key_filter_v2", "noise_suppress_filter_v2",
+				    "compressor_filter", "crop_filter", "sharpness_filter_v2", "limiter_filter",
+				    "mask_filter_v2", "scroll_filter", "gain_filter"};
+
+template<typename T, size_t N> const T &Pick(const T (&items)[N], std::mt19937 &rng)
+{
+	return items[std::uniform_int_distribution<size_t>(0, N - 1)(rng)];
+}
+
+} // namespace
+
+Corpus MakeCorpus(size_t sourceCount, uint32_t seed)
+{
+	std::mt19937 rng(seed);
+	Corpus corpus;
+
+	// About one scene per 40 sources
+	corpus.sceneCount = std::max<size_t>(8, sourceCount / 40);
+	corpus.sceneContainers.resize(corpus.sceneCount);
+	for (size_t i = 0; i < corpus.sceneCount; i++) {
+		corpus.rows.push_back({std::string(Pick(kScenePrefixes, rng)) + " " + std::to_string(i + 1), "scene",
+				       SourceIndex::ClassScene, 0});
+
+		// A fifth of the scenes are nested in an earlier one (keeps it acyclic)
+		if (i > 0 && std::uniform_int_distribution<int>(0, 4)(rng) == 0) {
+			uint32_t container = std::uniform_int_distribution<uint32_t>(0, static_cast<uint32_t>(i - 1))(rng);
+			corpus.sceneContainers[i].push_back(container);
+			corpus.rows.back().flags = SourceIndex::FlagHasParentScene;
+		}
+	}
+
+	unsigned totalWeight = 0;
+	for (const auto &type : kSourceTypes)
+		totalWeight += type.weight;
+
+	std::uniform_int_distribution<unsigned> typeRoll(0, totalWeight - 1);
+	std::uniform_int_distribution<int> percent(0, 99);
+
+	size_t sources = corpus.sceneCount;
+	size_t serial = 0;
+	while (sources < sourceCount) {
+		unsigned roll = typeRoll(rng);
+		const char *typeId = kSourceTypes[0].id;
+		for (const auto &type : kSourceTypes) {
+			if (roll < type.weight) {
+				typeId = type.id;
+				break;
+			}
+			roll -= type.weight;
+		}
+
+		std::string name = std::string(Pick(kPrefixes, rng)) + " " + Pick(kNouns, rng) + " " +
+				   std::to_string(++serial % 50 + 1);
+		if (percent(rng) < 10)
+			name = "[Show " + std::to_string(serial % 7 + 1) + "] " + name;
+
+		// Most sources sit in a scene; the rest are internal or unused
+		uint8_t flags = percent(rng) < 95 ? SourceIndex::FlagHasParentScene : 0;
+		corpus.rows.push_back({std::move(name), typeId, SourceIndex::ClassSource, flags});
+		sources++;
+
+		// Roughly half of the sources carry a filter or two
+		int filters = percent(rng) < 50 ? 1 + (percent(rng) < 30) : 0;
+		for (int f = 0; f < filters; f++) {
+			size_t pick = std::uniform_int_distribution<size_t>(0, std::size(kFilterNames) - 1)(rng);
+			corpus.rows.push_back({kFilterNames[pick], kFilterTypes[pick], SourceIndex::ClassFilter, 0});
+		}
+	}
+
+	return corpus;
+}
+
+const Corpus &GetCorpus(size_t sourceCount)
+{
+	static std::map<size_t, std::unique_ptr<Corpus>> cache;
+	auto &slot = cache[sourceCount];
+	if (!slot)
+		slot = std::make_unique<Corpus>(MakeCorpus(sourceCount, 42));
+	return *slot;
+}
+
+void LoadIndex(const Corpus &corpus, SourceIndex &index)
+{
+	index.Clear();
+	index.BeginBulkLoad();
+	for (const auto &row : corpus.rows) {
+		index.Add(row.name, row.typeId, row.classByte, row.flags);
+	}
+	index.SortRows();
+}
+
+void LoadSceneGraph(const Corpus &corpus, SceneGraph &graph)
+{
+	graph.Clear();
+	for (size_t i = 0; i < corpus.sceneCount; i++) {
+		graph.SetContainers(static_cast<uint32_t>(i), corpus.sceneContainers[i]);
+	}
+}
@@ -0,0 +1,46 @@
+/*
+ * OBS Source Search Plugin
+ * Copyright (C) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "scene-graph.hpp"
+#include "source-index.hpp"
+
+// Synthetic scene collection shaped like a large show: scenes (some nested
+// in others), sources placed in one to three scenes, a few orphaned
+// internal sources, and filters on about half of everything.
+struct Corpus {
+	struct Row {
+		std::string name;
+		std::string typeId;
+		uint8_t classByte;
+		uint8_t flags;
+	};
+	std::vector<Row> rows;
+
+	// Scene rows come first; sceneContainers[i] lists the scenes that
+	// scene i is nested in (sorted)
+	size_t sceneCount = 0;
+	std::vector<std::vector<uint32_t>> sceneContainers;
+};
+
+// Deterministic for a given size and seed; sourceCount excludes filters
+const Corpus &GetCorpus(size_t sourceCount);
+Corpus MakeCorpus(size_t sourceCount, uint32_t seed);
+
+// Bulk load every row and sort, like SourceCollection::Refresh()
+void LoadIndex(const Corpus &corpus, SourceIndex &index);
+
+void LoadSceneGraph(const Corpus &corpus, SceneGraph &graph);
@@ -0,0 +1,345 @@
+/*
+ * OBS Source Search Plugin
+ * Copyright (C) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ */
+
+// Search core benchmarks over synthetic corpora, without libobs or Qt.
+// Sizes are source counts (filters come on top):
+//   source-search-bench --benchmark_filter=Match
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "corpus.hpp"
+#include "index-search.hpp"
+#include "scene-graph.hpp"
+#include "search-matcher.hpp"
+#include "source-index.hpp"
+
+namespace {
+
+void CorpusSizes(benchmark::internal::Benchmark *bench)
+{
+	bench->Arg(1000)->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+}
+
+// Loaded indexes are reused across benchmarks of the same size
+const SourceIndex &GetIndex(size_t sourceCount)
+{
+	static std::vector<std::pair<size_t, std::unique_ptr<SourceIndex>>> cache;
+	for (auto &[size, index] : cache) {
+		if (size == sourceCount)
+			return *index;
+	}
+
+	auto index = std::make_unique<SourceIndex>();
+	LoadIndex(GetCorpus(sourceCount), *index);
+	cache.emplace_back(sourceCount, std::move(index));
+	return *cache.back().second;
+}
+
+std::vector<std::string> FoldedNames(const Corpus &corpus)
+{
+	std::vector<std::string> names;
+	names.reserve(corpus.rows.size());
+	for (const auto &row : corpus.rows)
+		names.push_back(FoldSearchText(row.name));
+	return names;
+}
+
+template<bool Scalar> void BM_Matcher(benchmark::State &state)
+{
+	auto names = FoldedNames(GetCorpus(static_cast<size_t>(state.range(0))));
+	const std::string needle = "camera";
+
+	size_t bytes = 0;
+	for (const auto &name : names)
+		bytes += name.size();
+
+	for (auto _ : state) {
+		size_t hits = 0;
+		for (const auto &name : names) {
+			hits += Scalar ? ContainsFoldedScalar(name.data(), name.size(), needle.data(), needle.size())
+				       : ContainsFolded(name.data(), name.size(), needle.data(), needle.size());
+		}
+		benchmark::DoNotOptimize(hits);
+	}
+	state.SetBytesProcessed(static_cast<int64_t>(bytes * state.iterations()));
+}
+
+void RunQuery(benchmark::State &state, const std::string &query, SearchScope scope, SearchMode mode)
+{
+	const SourceIndex &index = GetIndex(static_cast<size_t>(state.range(0)));
+	IndexSearch search;
+	std::vector<SourceIndex::Row> rows;
+
+	for (auto _ : state) {
+		search.Reset();  // Measure a full scan, not the narrowing path
+		search.Run(index, ParseSearchQuery(query), "all", scope, mode, rows);
+		benchmark::DoNotOptimize(rows.data());
+	}
+	state.counters["results"] = static_cast<double>(rows.size());
+}
+
+// Stand-in for the plugin's ScanPool (Qt-free): persistent helpers pull
+// chunks from a shared counter while the calling thread does the same
+class BenchExecutor : public ScanExecutor {
+public:
+	explicit BenchExecutor(size_t helperCount)
+	{
+		for (size_t i = 0; i < helperCount; i++)
+			threads.emplace_back([this]() { HelperLoop(); });
+	}
+
+	~BenchExecutor() override
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stopping = true;
+		}
+		wake.notify_all();
+		for (auto &thread : threads)
+			thread.join();
+	}
+
+	size_t Concurrency() const override { return threads.size() + 1; }
+
+	void Run(size_t count, const std::function<void(size_t)> &task) override
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			current = &task;
+			total = count;
+			next = 0;
+			busy = threads.size();
+			batch++;
+		}
+		wake.notify_all();
+
+		Work(task, count);
+
+		std::unique_lock<std::mutex> lock(mutex);
+		done.wait(lock, [this]() { return busy == 0; });
+		current = nullptr;
+	}
+
+private:
+	void Work(const std::function<void(size_t)> &task, size_t count)
+	{
+		for (size_t chunk = next++; chunk < count; chunk = next++)
+			task(chunk);
+	}
+
+	void HelperLoop()
+	{
+		uint64_t seen = 0;
+		std::unique_lock<std::mutex> lock(mutex);
+		for (;;) {
+			wake.wait(lock, [&]() { return stopping || batch != seen; });
+			if (stopping)
+				return;
+			seen = batch;
+
+			const std::function<void(size_t)> *task = current;
+			size_t count = total;
+			lock.unlock();
+			Work(*task, count);
+			lock.lock();
+
+			if (--busy == 0)
+				done.notify_one();
+		}
+	}
+
+	std::vector<std::thread> threads;
+	std::mutex mutex;
+	std::condition_variable wake;
+	std::condition_variable done;
+	const std::function<void(size_t)> *current = nullptr;
+	size_t total = 0;
+	std::atomic<size_t> next{0};
+	size_t busy = 0;
+	uint64_t batch = 0;
+	bool stopping = false;
+};
+
+// Same query with the scan split over helpers (the plugin caps them at 3)
+void RunParallelQuery(benchmark::State &state, const std::string &query, SearchScope scope, SearchMode mode)
+{
+	size_t cores = std::thread::hardware_concurrency();
+	size_t helpers = std::clamp<size_t>(cores > 1 ? cores - 1 : 1, 1, 3);
+	BenchExecutor executor(helpers);
+	SourceIndex::SetScanExecutor(&executor);
+	RunQuery(state, query, scope, mode);
+	SourceIndex::SetScanExecutor(nullptr);
+	state.counters["threads"] = static_cast<double>(executor.Concurrency());
+}
+
+void BM_MatchEmpty(benchmark::State &state)
+{
+	RunQuery(state, "", SearchScope::All, SearchMode::Contains);
+}
+
+void BM_MatchBroad(benchmark::State &state)
+{
+	RunQuery(state, "cam", SearchScope::Sources, SearchMode::Contains);
+}
+
+void BM_MatchSelective(benchmark::State &state)
+{
+	// Long enough for the trigram path on large corpora
+	RunQuery(state, "booth camera 12", SearchScope::Sources, SearchMode::Contains);
+}
+
+void BM_MatchTypeFilter(benchmark::State &state)
+{
+	const SourceIndex &index = GetIndex(static_cast<size_t>(state.range(0)));
+	IndexSearch search;
+	std::vector<SourceIndex::Row> rows;
+
+	for (auto _ : state) {
+		search.Reset();
+		search.Run(index, ParseSearchQuery("overlay"), "browser_source", SearchScope::Sources,
+			   SearchMode::Contains, rows);
+		benchmark::DoNotOptimize(rows.data());
+	}
+	state.counters["results"] = static_cast<double>(rows.size());
+}
+
+void BM_MatchStructured(benchmark::State &state)
+{
+	// Parsing and compiling included, as per keystroke in the dock
+	RunQuery(state, "cam type:dshow_input type:window_capture -group", SearchScope::All,
+		 SearchMode::Contains);
+}
+
+void BM_MatchFuzzy(benchmark::State &state)
+{
+	RunQuery(state, "bcam2", SearchScope::Sources, SearchMode::Fuzzy);
+}
+
+void BM_MatchBroadParallel(benchmark::State &state)
+{
+	RunParallelQuery(state, "cam", SearchScope::Sources, SearchMode::Contains);
+}
+
+void BM_MatchFuzzyParallel(benchmark::State &state)
+{
+	RunParallelQuery(state, "bcam2", SearchScope::Sources, SearchMode::Fuzzy);
+}
+
+void BM_TypingNarrowing(benchmark::State &state)
+{
+	// One query per keystroke, as the dock issues them
+	const SourceIndex &index = GetIndex(static_cast<size_t>(state.range(0)));
+	const std::string typed = "booth camera 2";
+	IndexSearch search;
+	std::vector<SourceIndex::Row> rows;
+
+	for (auto _ : state) {
+		search.Reset();
+		for (size_t length = 1; length <= typed.size(); length++) {
+			search.Run(index, ParseSearchQuery(typed.substr(0, length)), "all", SearchScope::Sources,
+				   SearchMode::Contains, rows);
+		}
+		benchmark::DoNotOptimize(rows.data());
+	}
+}
+
+void BM_BulkLoadAndSort(benchmark::State &state)
+{
+	const Corpus &corpus = GetCorpus(static_cast<size_t>(state.range(0)));
+	SourceIndex index;
+
+	for (auto _ : state) {
+		LoadIndex(corpus, index);
+		benchmark::DoNotOptimize(index.Size());
+	}
+	state.counters["rows"] = static_cast<double>(corpus.rows.size());
+}
+
+void BM_IncrementalAddRemove(benchmark::State &state)
+{
+	// Source created, renamed and destroyed on a loaded index
+	SourceIndex index;
+	LoadIndex(GetCorpus(static_cast<size_t>(state.range(0))), index);
+
+	size_t serial = 0;
+	for (auto _ : state) {
+		SourceIndex::Row row = index.Add("Guest Camera " + std::to_string(serial++), "dshow_input",
+						 SourceIndex::ClassSource, SourceIndex::FlagHasParentScene);
+		index.SetName(row, "Renamed Camera");
+		index.Remove(row);
+	}
+}
+
+void BM_SceneClosure(benchmark::State &state)
+{
+	const Corpus &corpus = GetCorpus(static_cast<size_t>(state.range(0)));
+	SceneGraph graph;
+	std::vector<uint32_t> nested;
+
+	for (auto _ : state) {
+		LoadSceneGraph(corpus, graph);
+		graph.Update();
+		graph.CollectNested({static_cast<uint32_t>(corpus.sceneCount - 1)}, nested);
+		benchmark::DoNotOptimize(nested.data());
+	}
+	state.counters["scenes"] = static_cast<double>(corpus.sceneCount);
+}
+
+void BM_SceneRelink(benchmark::State &state)
+{
+	// One nested scene linked and unlinked again, as by item_add/item_remove
+	const Corpus &corpus = GetCorpus(static_cast<size_t>(state.range(0)));
+	SceneGraph graph;
+	LoadSceneGraph(corpus, graph);
+	graph.Update();
+
+	uint32_t scene = static_cast<uint32_t>(corpus.sceneCount / 2);
+	std::vector<uint32_t> original = corpus.sceneContainers[scene];
+	std::vector<uint32_t> linked = original;
+	uint32_t container = static_cast<uint32_t>(corpus.sceneCount - 1);
+	if (!std::binary_search(linked.begin(), linked.end(), container))
+		linked.insert(std::upper_bound(linked.begin(), linked.end(), container), container);
+
+	bool toggle = false;
+	for (auto _ : state) {
+		toggle = !toggle;
+		graph.SetContainers(scene, toggle ? linked : original);
+		graph.Update();
+	}
+	state.counters["scenes"] = static_cast<double>(corpus.sceneCount);
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_Matcher, false)->Apply(CorpusSizes)->Name("BM_ContainsFolded");
+BENCHMARK_TEMPLATE(BM_Matcher, true)->Apply(CorpusSizes)->Name("BM_ContainsFoldedScalar");
+BENCHMARK(BM_MatchEmpty)->Apply(CorpusSizes);
+BENCHMARK(BM_MatchBroad)->Apply(CorpusSizes);
+BENCHMARK(BM_MatchSelective)->Apply(CorpusSizes);
+BENCHMARK(BM_MatchTypeFilter)->Apply(CorpusSizes);
+BENCHMARK(BM_MatchStructured)->Apply(CorpusSizes);
+BENCHMARK(BM_MatchFuzzy)->Apply(CorpusSizes);
+BENCHMARK(BM_MatchBroadParallel)->Apply(CorpusSizes);
+BENCHMARK(BM_MatchFuzzyParallel)->Apply(CorpusSizes);
+BENCHMARK(BM_TypingNarrowing)->Apply(CorpusSizes);
+BENCHMARK(BM_BulkLoadAndSort)->Apply(CorpusSizes);
+BENCHMARK(BM_IncrementalAddRemove)->Apply(CorpusSizes);
+BENCHMARK(BM_SceneClosure)->Apply(CorpusSizes);
+BENCHMARK(BM_SceneRelink)->Apply(CorpusSizes);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,86 @@
+/*
+ * OBS Source Search Plugin
+ * Copyright (C) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ */
+
+#include "collection-cache.hpp"
+#include "latency-stats.hpp"
+
+#include <obs-module.h>
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+
+CollectionCache::Files CollectionCache::Rescan(const QString &directory, const Files &previous, ScanStats &stats)
+{
+	uint64_t start = LatencyNow();
+	Files files;
+
+	// Backups (*.json.bak) and other files are left alone
+	QDir dir(directory);
+	const QFileInfoList infos = dir.entryInfoList(QStringList() << "*.json", QDir::Files, QDir::Name);
+
+	for (const QFileInfo &info : infos) {
+		std::string path = info.absoluteFilePath().toStdString();
+		int64_t modified = info.lastModified().toMSecsSinceEpoch();
+		int64_t size = info.size();
+
+		auto cached = previous.find(path);
+		if (cached != previous.end() && cached->second->modified == modified && cached->second->size == size) {
+			files.emplace(path, cached->second);
+			stats.reused++;
+			continue;
+		}
+
+		QFile file(info.absoluteFilePath());
+		if (size <= 0 || !file.open(QIODevice::ReadOnly)) {
+			stats.failed++;
+			continue;
+		}
+
+		const uchar *data = file.map(0, size);
+		if (!data) {
+			stats.failed++;
+			continue;
+		}
+
+		auto indexed = std::make_shared<IndexedCollection>();
+		indexed->path = path;
+		indexed->modified = modified;
+		indexed->size = size;
+		bool parsed = ParseCollectionFile(reinterpret_cast<const char *>(data), static_cast<size_t>(size),
+						  indexed->file);
+		file.unmap(const_cast<uchar *>(data));
+
+		if (!parsed) {
+			stats.failed++;
+			continue;
+		}
+
+		IndexCollectionFile(indexed->file, indexed->index);
+		GraphCollectionFile(indexed->file, indexed->scenes);
+		files.emplace(path, std::move(indexed));
+		stats.parsed++;
+	}
+
+	stats.elapsedNs = LatencyNow() - start;
+	return files;
+}
+
+QString CollectionCache::CollectionsDirectory()
+{
+	// <config>/obs-studio/plugin_config/<module>/ -> <config>/obs-studio/basic/scenes
+	char *moduleDir = obs_module_config_path("");
+	if (!moduleDir)
+		return QString();
+
+	QString path = QDir::cleanPath(QString::fromUtf8(moduleDir) + "/../../basic/scenes");
+	bfree(moduleDir);
+	return path;
+}
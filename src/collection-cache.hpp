@@ -0,0 +1,54 @@
+/*
+ * OBS Source Search Plugin
+ * Copyright (C) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ */
+
+#pragma once
+
+#include <QString>
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+
+#include "collection-file.hpp"
+#include "source-index.hpp"
+
+// A parsed and indexed scene collection file. Never modified once built,
+// so the scan worker and the UI thread share it freely.
+struct IndexedCollection {
+	std::string path;
+	int64_t modified = 0;  // ms since epoch
+	int64_t size = 0;
+	CollectionFile file;
+	SourceIndex index;  // Row N is file.entries[N]
+	SceneGraph scenes;  // Nesting over entry IDs
+};
+
+// The scene collection files next to the loaded one, cached per file by
+// modification time and size
+class CollectionCache {
+public:
+	using Entry = std::shared_ptr<const IndexedCollection>;
+	using Files = std::map<std::string, Entry>;  // By path
+
+	struct ScanStats {
+		size_t parsed = 0;
+		size_t reused = 0;
+		size_t failed = 0;
+		uint64_t elapsedNs = 0;
+	};
+
+	// Any thread: list the directory and memory-map and parse only the
+	// files that are new or changed since `previous`
+	static Files Rescan(const QString &directory, const Files &previous, ScanStats &stats);
+
+	// OBS's basic/scenes directory, next to the plugin config dir (UI thread)
+	static QString CollectionsDirectory();
+};
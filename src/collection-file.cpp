@@ -0,0 +1,529 @@
+/*
+ * OBS Source Search Plugin
+ * Copyright (C) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ */
+
+#include "collection-file.hpp"
+#include "search-matcher.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+
+namespace {
+
+// Forward-only reader over JSON text. Any syntax error sets `failed`,
+// which ends every loop below.
+struct JsonCursor {
+	const char *pos;
+	const char *end;
+	bool failed = false;
+
+	void SkipSpace()
+	{
+		while (pos < end && (*pos == ' ' || *pos == '\n' || *pos == '\r' || *pos == '\t'))
+			pos++;
+	}
+
+	bool Consume(char c)
+	{
+		SkipSpace();
+		if (pos < end && *pos == c) {
+			pos++;
+			return true;
+		}
+		return false;
+	}
+
+	bool Expect(char c)
+	{
+		if (!Consume(c))
+			failed = true;
+		return !failed;
+	}
+
+	bool PeekString()
+	{
+		SkipSpace();
+		return pos < end && *pos == '"';
+	}
+
+	// Read a string value (out may be null to skip it)
+	bool ReadString(std::string *out);
+
+	// Skip any value, nested ones without recursion
+	void SkipValue();
+
+	// A string value, or skip whatever is there instead
+	void ReadStringOrSkip(std::string &out)
+	{
+		if (PeekString())
+			ReadString(&out);
+		else
+			SkipValue();
+	}
+};
+
+void AppendUtf8(uint32_t code, std::string &out)
+{
+	if (code < 0x80) {
+		out += static_cast<char>(code);
+	} else if (code < 0x800) {
+		out += static_cast<char>(0xC0 | (code >> 6));
+		out += static_cast<char>(0x80 | (code & 0x3F));
+	} else if (code < 0x10000) {
+		out += static_cast<char>(0xE0 | (code >> 12));
+		out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+		out += static_cast<char>(0x80 | (code & 0x3F));
+	} else {
+		out += static_cast<char>(0xF0 | (code >> 18));
+		out += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+		out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+		out += static_cast<char>(0x80 | (code & 0x3F));
+	}
+}
+
+bool ReadHex4(const char *p, const char *end, uint32_t &code)
+{
+	if (end - p < 4)
+		return false;
+
+	code = 0;
+	for (int i = 0; i < 4; i++) {
+		char c = p[i];
+		code <<= 4;
+		if (c >= '0' && c <= '9')
+			code |= static_cast<uint32_t>(c - '0');
+		else if (c >= 'a' && c <= 'f')
+			code |= static_cast<uint32_t>(c - 'a' + 10);
+		else if (c >= 'A' && c <= 'F')
+			code |= static_cast<uint32_t>(c - 'A' + 10);
+		else
+			return false;
+	}
+	return true;
+}
+
+bool JsonCursor::ReadString(std::string *out)
+{
+	if (!Expect('"'))
+		return false;
+
+	if (out)
+		out->clear();
+
+	while (pos < end) {
+		// Copy the plain run up to the next quote or escape at once
+		const char *run = pos;
+		while (pos < end && *pos != '"' && *pos != '\\')
+			pos++;
+		if (out)
+			out->append(run, static_cast<size_t>(pos - run));
+
+		if (pos >= end)
+			break;
+
+		if (*pos == '"') {
+			pos++;
+			return true;
+		}
+
+		// Escape
+		if (++pos >= end)
+			break;
+		char escaped = *pos++;
+		if (!out) {
+			if (escaped == 'u')
+				pos += std::min<ptrdiff_t>(4, end - pos);
+			continue;
+		}
+
+		switch (escaped) {
+		case 'b':
+			*out += '\b';
+			break;
+		case 'f':
+			*out += '\f';
+			break;
+		case 'n':
+			*out += '\n';
+			break;
+		case 'r':
+			*out += '\r';
+			break;
+		case 't':
+			*out += '\t';
+			break;
+		case 'u': {
+			uint32_t code;
+			if (!ReadHex4(pos, end, code)) {
+				failed = true;
+				return false;
+			}
+			pos += 4;
+
+			// Surrogate pair
+			uint32_t low;
+			if (code >= 0xD800 && code < 0xDC00 && end - pos >= 6 && pos[0] == '\\' && pos[1] == 'u' &&
+			    ReadHex4(pos + 2, end, low) && low >= 0xDC00 && low < 0xE000) {
+				code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+				pos += 6;
+			}
+			AppendUtf8(code, *out);
+			break;
+		}
+		default:
+			*out += escaped;  // \" \\ \/
+			break;
+		}
+	}
+
+	failed = true;
+	return false;
+}
+
+void JsonCursor::SkipValue()
+{
+	SkipSpace();
+	if (pos >= end) {
+		failed = true;
+		return;
+	}
+
+	if (*pos == '"') {
+		ReadString(nullptr);
+		return;
+	}
+
+	if (*pos != '{' && *pos != '[') {
+		// Number, true, false or null
+		const char *start = pos;
+		while (pos < end && !strchr(",}] \n\r\t", *pos))
+			pos++;
+		if (pos == start)
+			failed = true;
+		return;
+	}
+
+	size_t depth = 0;
+	while (pos < end) {
+		char c = *pos;
+		if (c == '"') {
+			if (!ReadString(nullptr))
+				return;
+			continue;
+		}
+
+		pos++;
+		if (c == '{' || c == '[') {
+			depth++;
+		} else if (c == '}' || c == ']') {
+			if (--depth == 0)
+				return;
+		}
+	}
+
+	failed = true;
+}
+
+// Members of one object: while (reader.Next(key)) { read or skip the value }
+struct ObjectReader {
+	JsonCursor &cursor;
+	bool first = true;
+
+	explicit ObjectReader(JsonCursor &c) : cursor(c) { cursor.Expect('{'); }
+
+	bool Next(std::string &key)
+	{
+		if (cursor.failed || cursor.Consume('}'))
+			return false;
+		if (!first && !cursor.Expect(','))
+			return false;
+		first = false;
+		return cursor.ReadString(&key) && cursor.Expect(':');
+	}
+};
+
+// Elements of one array: while (reader.Next()) { read or skip the value }
+struct ArrayReader {
+	JsonCursor &cursor;
+	bool first = true;
+
+	explicit ArrayReader(JsonCursor &c) : cursor(c) { cursor.Expect('['); }
+
+	bool Next()
+	{
+		if (cursor.failed || cursor.Consume(']'))
+			return false;
+		if (!first && !cursor.Expect(','))
+			return false;
+		first = false;
+		return true;
+	}
+};
+
+// A scene item as written: by name, and by UUID in newer files
+struct SceneItemRef {
+	std::string name;
+	std::string uuid;
+};
+
+struct ParsedSource {
+	CollectionEntry entry;
+	std::vector<SceneItemRef> items;
+	std::vector<CollectionEntry> filters;
+};
+
+void ReadItems(JsonCursor &cursor, std::vector<SceneItemRef> &items)
+{
+	std::string key;
+	ArrayReader array(cursor);
+	while (array.Next()) {
+		SceneItemRef item;
+		ObjectReader object(cursor);
+		while (object.Next(key)) {
+			if (key == "name")
+				cursor.ReadStringOrSkip(item.name);
+			else if (key == "source_uuid")
+				cursor.ReadStringOrSkip(item.uuid);
+			else
+				cursor.SkipValue();
+		}
+		items.push_back(std::move(item));
+	}
+}
+
+void ReadFilters(JsonCursor &cursor, std::vector<CollectionEntry> &filters)
+{
+	std::string key;
+	ArrayReader array(cursor);
+	while (array.Next()) {
+		CollectionEntry filter;
+		filter.classByte = SourceIndex::ClassFilter;
+		ObjectReader object(cursor);
+		while (object.Next(key)) {
+			if (key == "name")
+				cursor.ReadStringOrSkip(filter.name);
+			else if (key == "uuid")
+				cursor.ReadStringOrSkip(filter.uuid);
+			else if (key == "id")
+				cursor.ReadStringOrSkip(filter.typeId);
+			else
+				cursor.SkipValue();
+		}
+		filters.push_back(std::move(filter));
+	}
+}
+
+void ReadSource(JsonCursor &cursor, bool inGroups, ParsedSource &source)
+{
+	std::string key;
+	ObjectReader object(cursor);
+	while (object.Next(key)) {
+		if (key == "name") {
+			cursor.ReadStringOrSkip(source.entry.name);
+		} else if (key == "uuid") {
+			cursor.ReadStringOrSkip(source.entry.uuid);
+		} else if (key == "id") {
+			cursor.ReadStringOrSkip(source.entry.typeId);
+		} else if (key == "filters") {
+			ReadFilters(cursor, source.filters);
+		} else if (key == "settings") {
+			// Scenes and groups list their items here
+			ObjectReader settings(cursor);
+			while (settings.Next(key)) {
+				if (key == "items")
+					ReadItems(cursor, source.items);
+				else
+					cursor.SkipValue();
+			}
+		} else {
+			cursor.SkipValue();
+		}
+	}
+
+	if (inGroups || source.entry.typeId == "group")
+		source.entry.classByte = SourceIndex::ClassGroup;
+	else if (source.entry.typeId == "scene")
+		source.entry.classByte = SourceIndex::ClassScene;
+	else
+		source.items.clear();
+}
+
+void ReadSources(JsonCursor &cursor, bool inGroups, std::vector<ParsedSource> &sources)
+{
+	ArrayReader array(cursor);
+	while (array.Next()) {
+		sources.emplace_back();
+		ReadSource(cursor, inGroups, sources.back());
+	}
+}
+
+} // namespace
+
+bool ParseCollectionFile(const char *data, size_t size, CollectionFile &out)
+{
+	out = CollectionFile();
+
+	JsonCursor cursor{data, data + size};
+	std::vector<ParsedSource> sources;
+	bool sawSources = false;
+
+	std::string key;
+	ObjectReader root(cursor);
+	while (root.Next(key)) {
+		if (key == "name") {
+			cursor.ReadStringOrSkip(out.name);
+		} else if (key == "sources" || key == "groups") {
+			sawSources = true;
+			ReadSources(cursor, key == "groups", sources);
+		} else {
+			cursor.SkipValue();
+		}
+	}
+
+	if (cursor.failed || !sawSources)
+		return false;
+
+	// Sources first (rows match source order), filters after them
+	std::unordered_map<std::string, uint32_t> byUuid;
+	std::unordered_map<std::string, uint32_t> byName;
+	out.entries.reserve(sources.size());
+	for (auto &source : sources) {
+		uint32_t id = static_cast<uint32_t>(out.entries.size());
+		if (!source.entry.uuid.empty())
+			byUuid.emplace(source.entry.uuid, id);
+		byName.emplace(source.entry.name, id);
+		out.entries.push_back(source.entry);
+	}
+
+	// Items name their source by UUID in newer files, by name in older ones
+	auto resolve = [&](const SceneItemRef &item) {
+		auto it = item.uuid.empty() ? byUuid.end() : byUuid.find(item.uuid);
+		if (it != byUuid.end())
+			return it->second;
+		auto named = byName.find(item.name);
+		return named != byName.end() ? named->second : CollectionEntry::kNoParent;
+	};
+
+	for (uint32_t sceneId = 0; sceneId < sources.size(); sceneId++) {
+		for (const auto &item : sources[sceneId].items) {
+			uint32_t member = resolve(item);
+			if (member != CollectionEntry::kNoParent)
+				out.entries[member].parentScenes.push_back(sceneId);
+		}
+
+		for (auto &filter : sources[sceneId].filters) {
+			filter.parentSource = sceneId;
+			out.entries.push_back(std::move(filter));
+		}
+	}
+
+	for (auto &entry : out.entries) {
+		std::sort(entry.parentScenes.begin(), entry.parentScenes.end());
+		entry.parentScenes.erase(std::unique(entry.parentScenes.begin(), entry.parentScenes.end()),
+					 entry.parentScenes.end());
+	}
+
+	return true;
+}
+
+void IndexCollectionFile(const CollectionFile &file, SourceIndex &index)
+{
+	index.Clear();
+	index.BeginBulkLoad();
+	for (const auto &entry : file.entries) {
+		uint8_t flags = entry.parentScenes.empty() ? 0 : SourceIndex::FlagHasParentScene;
+		index.Add(entry.name, entry.typeId, entry.classByte, flags);
+	}
+	index.SortRows();
+}
+
+void GraphCollectionFile(const CollectionFile &file, SceneGraph &scenes)
+{
+	scenes.Clear();
+	for (uint32_t id = 0; id < file.entries.size(); id++) {
+		const CollectionEntry &entry = file.entries[id];
+		if (entry.classByte == SourceIndex::ClassScene || entry.classByte == SourceIndex::ClassGroup)
+			scenes.SetContainers(id, entry.parentScenes);
+	}
+	scenes.Update();
+}
+
+std::vector<uint64_t> CollectionNameTermRows(const CollectionFile &file, const SceneGraph &scenes,
+					     const SearchQuery &query)
+{
+	const auto &entries = file.entries;
+	std::vector<uint64_t> rows((entries.size() + 63) / 64, 0);
+
+	std::vector<std::string> foldedNames;
+	foldedNames.reserve(entries.size());
+	for (const auto &entry : entries) {
+		foldedNames.push_back(FoldSearchText(entry.name));
+	}
+
+	// in: names a scene or group, filter-on: anything a filter can be on
+	auto namesMatching = [&](const std::string &term, bool scenesOnly) {
+		std::string folded = FoldSearchText(term);
+		std::vector<uint32_t> ids;
+		for (uint32_t id = 0; id < entries.size(); id++) {
+			uint8_t classByte = entries[id].classByte;
+			bool isScene = classByte == SourceIndex::ClassScene || classByte == SourceIndex::ClassGroup;
+			if ((scenesOnly ? isScene : classByte != SourceIndex::ClassFilter) && foldedNames[id] == folded)
+				ids.push_back(id);
+		}
+		return ids;
+	};
+
+	std::vector<std::vector<uint32_t>> sceneIds;
+	for (const auto &scene : query.scenes) {
+		sceneIds.push_back(namesMatching(scene, true));
+	}
+
+	// Every in: term needs one scene of that name showing the entry
+	auto shownInAll = [&](const CollectionEntry &entry) {
+		for (const auto &ids : sceneIds) {
+			bool shown = false;
+			for (uint32_t sceneId : ids) {
+				if (scenes.IsVisibleIn(entry.parentScenes, sceneId)) {
+					shown = true;
+					break;
+				}
+			}
+			if (!shown)
+				return false;
+		}
+		return true;
+	};
+
+	auto mark = [&rows](uint32_t row) { rows[row / 64] |= uint64_t(1) << (row % 64); };
+
+	if (query.filterOn.empty()) {
+		for (uint32_t row = 0; row < entries.size(); row++) {
+			if (shownInAll(entries[row]))
+				mark(row);
+		}
+		return rows;
+	}
+
+	// Only the filters on the named parents are candidates
+	std::vector<uint8_t> parents(entries.size(), 0);
+	for (const auto &parent : query.filterOn) {
+		for (uint32_t id : namesMatching(parent, false)) {
+			parents[id] = 1;
+		}
+	}
+
+	for (uint32_t row = 0; row < entries.size(); row++) {
+		const CollectionEntry &entry = entries[row];
+		if (entry.parentSource < entries.size() && parents[entry.parentSource] && shownInAll(entry))
+			mark(row);
+	}
+
+	return rows;
+}
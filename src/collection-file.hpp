@@ -0,0 +1,56 @@
+/*
+ * OBS Source Search Plugin
+ * Copyright (C) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "scene-graph.hpp"
+#include "search-query.hpp"
+#include "source-index.hpp"
+
+// One source, scene, group or filter read from a scene collection file
+struct CollectionEntry {
+	static constexpr uint32_t kNoParent = UINT32_MAX;
+
+	std::string name;
+	std::string uuid;
+	std::string typeId;
+	uint8_t classByte = SourceIndex::ClassSource;
+	uint32_t parentSource = kNoParent;   // Filters: the entry they're on
+	std::vector<uint32_t> parentScenes;  // Entries of the scenes/groups holding it, sorted
+};
+
+// What the search needs from a scene collection JSON file (basic/scenes)
+struct CollectionFile {
+	std::string name;  // Collection name as stored in the file
+	std::vector<CollectionEntry> entries;
+};
+
+// Single pass over the JSON text without building a document: only the
+// collection name and each source's name, id, uuid, scene items and
+// filters are kept, everything else is skipped. No source is created.
+// False (and out is incomplete) if the text isn't a collection file.
+bool ParseCollectionFile(const char *data, size_t size, CollectionFile &out);
+
+// Index rows mirror file.entries
+void IndexCollectionFile(const CollectionFile &file, SourceIndex &index);
+
+// Scene/group nesting over entry IDs (for in: terms through nested scenes)
+void GraphCollectionFile(const CollectionFile &file, SceneGraph &scenes);
+
+// Rows passing a query's in:/filter-on: terms, one bit per entry, resolved
+// against the file's own names and links the way the live collection
+// resolves them (see IndexSearch::Run's nameRows)
+std::vector<uint64_t> CollectionNameTermRows(const CollectionFile &file, const SceneGraph &scenes,
+					     const SearchQuery &query);
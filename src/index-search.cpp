@@ -0,0 +1,120 @@
+/*
+ * OBS Source Search Plugin
+ * Copyright (C) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ */
+
+#include "index-search.hpp"
+
+#include "search-matcher.hpp"
+
+bool IndexSearch::Compile(const SourceIndex &index, const SearchQuery &query, const std::string &typeFilter,
+			  SearchScope scope, const std::vector<uint64_t> *nameRows, SourceIndex::RowFilter &out)
+{
+	out = SourceIndex::RowFilter();
+
+	// Class terms replace the scope combo
+	constexpr uint8_t filterBit = 1 << SourceIndex::ClassFilter;
+	if (query.classes)
+		out.classMask = query.classes;
+	else if (scope == SearchScope::Sources)
+		out.classMask = static_cast<uint8_t>(0x0F & ~filterBit);
+	else if (scope == SearchScope::Filters)
+		out.classMask = filterBit;
+	out.classMask = static_cast<uint8_t>(out.classMask & ~query.excludedClasses);
+	if (!out.classMask)
+		return false;
+
+	// Type combo and type: terms both have to hold; -type: removes
+	bool anyType = typeFilter.empty() || typeFilter == "all";
+	if (!anyType || !query.types.empty() || !query.excludedTypes.empty()) {
+		out.typeAllowed.assign(index.TypeCount(), query.types.empty() ? 1 : 0);
+
+		for (const auto &typeId : query.types) {
+			uint32_t typeIndex = index.FindType(typeId);
+			if (typeIndex != SourceIndex::kNoType)
+				out.typeAllowed[typeIndex] = 1;
+		}
+
+		if (!anyType) {
+			uint32_t comboIndex = index.FindType(typeFilter);
+			if (comboIndex == SourceIndex::kNoType)
+				return false;
+			uint8_t kept = out.typeAllowed[comboIndex];
+			out.typeAllowed.assign(out.typeAllowed.size(), 0);
+			out.typeAllowed[comboIndex] = kept;
+		}
+
+		for (const auto &typeId : query.excludedTypes) {
+			uint32_t typeIndex = index.FindType(typeId);
+			if (typeIndex != SourceIndex::kNoType)
+				out.typeAllowed[typeIndex] = 0;
+		}
+
+		bool anyAllowed = false;
+		for (uint8_t allowed : out.typeAllowed) {
+			anyAllowed |= allowed != 0;
+		}
+		if (!anyAllowed)
+			return false;
+	}
+
+	out.matchSettings = query.matchSettings;
+
+	if (nameRows) {
+		out.rowMask = *nameRows;
+		out.hasRowMask = true;
+	}
+
+	return true;
+}
+
+bool IndexSearch::Run(const SourceIndex &index, const SearchQuery &query, const std::string &typeFilter,
+		      SearchScope scope, SearchMode mode, std::vector<SourceIndex::Row> &rows,
+		      const std::vector<uint64_t> *nameRows, const CancelToken &cancel)
+{
+	rows.clear();
+
+	// One compiled plan for the whole scan
+	SourceIndex::RowFilter compiled;
+	if (!Compile(index, query, typeFilter, scope, nameRows, compiled)) {
+		valid = false;
+		return true;
+	}
+
+	// Fold the query once instead of per comparison
+	std::string folded = FoldSearchText(query.text);
+
+	// Fuzzy results are ranked and truncated, so they can't seed narrowing
+	if (mode == SearchMode::Fuzzy && !folded.empty()) {
+		valid = false;
+		index.MatchFuzzy(folded, compiled, SourceIndex::kFuzzyResultLimit, rows, cancel);
+		return !cancel.Cancelled();
+	}
+
+	// Typing more characters can only narrow the previous result set
+	bool narrowing = valid && generation == index.Generation() && filter == compiled &&
+			 folded.find(foldedText) != std::string::npos;
+
+	if (narrowing)
+		index.MatchCandidates(folded, compiled.matchSettings, candidates, rows, cancel);
+	else
+		index.Match(folded, compiled, rows, cancel);
+
+	// Partial rows must not seed the next narrowing
+	if (cancel.Cancelled()) {
+		valid = false;
+		return false;
+	}
+
+	valid = true;
+	generation = index.Generation();
+	foldedText = std::move(folded);
+	filter = std::move(compiled);
+	candidates = rows;
+	return true;
+}
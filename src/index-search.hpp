@@ -0,0 +1,50 @@
+/*
+ * OBS Source Search Plugin
+ * Copyright (C) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "search-query.hpp"
+#include "source-index.hpp"
+
+// Query front end for a SourceIndex, free of libobs: compiles the query
+// terms, scope and type filter into one RowFilter, folds the text, picks
+// the fuzzy or substring path and remembers the last substring query so
+// one that extends it only re-checks those rows. SourceCollection maps the
+// resulting rows back to its items.
+class IndexSearch {
+public:
+	// Matching rows, in name order (fuzzy: best first, at most
+	// SourceIndex::kFuzzyResultLimit). in:/filter-on: terms are resolved
+	// by the caller into nameRows (bit per row); without it they are
+	// ignored. False if cancelled (rows are then incomplete).
+	bool Run(const SourceIndex &index, const SearchQuery &query, const std::string &typeFilter,
+		 SearchScope scope, SearchMode mode, std::vector<SourceIndex::Row> &rows,
+		 const std::vector<uint64_t> *nameRows = nullptr, const CancelToken &cancel = CancelToken());
+
+	// Forget the narrowing candidates
+	void Reset() { valid = false; }
+
+private:
+	// False if the filter can't match any row
+	static bool Compile(const SourceIndex &index, const SearchQuery &query, const std::string &typeFilter,
+			    SearchScope scope, const std::vector<uint64_t> *nameRows, SourceIndex::RowFilter &out);
+
+	// Last query and its matching rows; a query that extends it (same
+	// filters, unchanged index) only re-checks these candidates
+	bool valid = false;
+	uint64_t generation = 0;
+	std::string foldedText;
+	SourceIndex::RowFilter filter;
+	std::vector<SourceIndex::Row> candidates;
+};
@@ -0,0 +1,164 @@
+/*
+ * OBS Source Search Plugin
+ * Copyright (C) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ */
+
+#include "index-snapshot.hpp"
+
+#include <cstring>
+
+namespace {
+
+constexpr uint32_t kMagic = 0x58495353;  // "SSIX"
+constexpr uint32_t kVersion = 1;
+
+struct FileHeader {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t recordCount;
+	uint32_t linkCount;
+	uint32_t stringBytes;
+	uint32_t reserved;
+};
+
+struct FileRecord {
+	uint32_t name, nameLength;
+	uint32_t uuid, uuidLength;
+	uint32_t type, typeLength;
+	uint32_t parentSource;
+	uint32_t firstLink, linkCount;
+	uint8_t classByte;
+	uint8_t vertical;
+	uint16_t reserved;
+};
+
+static_assert(sizeof(FileHeader) == 24, "snapshot header layout");
+static_assert(sizeof(FileRecord) == 40, "snapshot record layout");
+
+bool SliceFits(uint64_t offset, uint64_t length, uint64_t size)
+{
+	return offset <= size && length <= size - offset;
+}
+
+} // namespace
+
+uint32_t SnapshotWriter::Store(const std::string &text)
+{
+	uint32_t offset = static_cast<uint32_t>(strings.size());
+	strings += text;
+	return offset;
+}
+
+void SnapshotWriter::Add(const std::string &name, const std::string &uuid, const std::string &typeId,
+			 uint8_t classByte, bool vertical, uint32_t parentSource,
+			 const std::vector<uint32_t> &parentScenes)
+{
+	PendingRecord record;
+	record.name = Store(name);
+	record.nameLength = static_cast<uint32_t>(name.size());
+	record.uuid = Store(uuid);
+	record.uuidLength = static_cast<uint32_t>(uuid.size());
+	record.type = Store(typeId);
+	record.typeLength = static_cast<uint32_t>(typeId.size());
+	record.parentSource = parentSource;
+	record.firstLink = static_cast<uint32_t>(links.size());
+	record.linkCount = static_cast<uint32_t>(parentScenes.size());
+	record.classByte = classByte;
+	record.vertical = vertical ? 1 : 0;
+	records.push_back(record);
+
+	links.insert(links.end(), parentScenes.begin(), parentScenes.end());
+}
+
+std::string SnapshotWriter::Finish() const
+{
+	FileHeader header = {kMagic, kVersion, static_cast<uint32_t>(records.size()),
+			     static_cast<uint32_t>(links.size()), static_cast<uint32_t>(strings.size()), 0};
+
+	std::string out;
+	out.reserve(sizeof(header) + records.size() * sizeof(FileRecord) + links.size() * sizeof(uint32_t) +
+		    strings.size());
+	out.append(reinterpret_cast<const char *>(&header), sizeof(header));
+
+	for (const PendingRecord &pending : records) {
+		FileRecord record = {pending.name,       pending.nameLength,   pending.uuid,
+				     pending.uuidLength, pending.type,         pending.typeLength,
+				     pending.parentSource, pending.firstLink,  pending.linkCount,
+				     pending.classByte,  pending.vertical,     0};
+		out.append(reinterpret_cast<const char *>(&record), sizeof(record));
+	}
+
+	out.append(reinterpret_cast<const char *>(links.data()), links.size() * sizeof(uint32_t));
+	out += strings;
+	return out;
+}
+
+bool SnapshotReader::Open(const void *data, size_t size)
+{
+	recordCount = 0;
+	if (!data || size < sizeof(FileHeader))
+		return false;
+
+	FileHeader header;
+	memcpy(&header, data, sizeof(header));
+	if (header.magic != kMagic || header.version != kVersion)
+		return false;
+
+	const unsigned char *bytes = static_cast<const unsigned char *>(data);
+	uint64_t recordBytes = uint64_t(header.recordCount) * sizeof(FileRecord);
+	uint64_t linkBytes = uint64_t(header.linkCount) * sizeof(uint32_t);
+	if (sizeof(header) + recordBytes + linkBytes + header.stringBytes != size)
+		return false;
+
+	records = bytes + sizeof(header);
+	links = records + recordBytes;
+	strings = reinterpret_cast<const char *>(links + linkBytes);
+
+	// Validate every slice once so Get() can trust them
+	for (uint32_t i = 0; i < header.recordCount; i++) {
+		FileRecord record;
+		memcpy(&record, records + uint64_t(i) * sizeof(FileRecord), sizeof(record));
+
+		if (!SliceFits(record.name, record.nameLength, header.stringBytes) ||
+		    !SliceFits(record.uuid, record.uuidLength, header.stringBytes) ||
+		    !SliceFits(record.type, record.typeLength, header.stringBytes) ||
+		    !SliceFits(record.firstLink, record.linkCount, header.linkCount))
+			return false;
+		if (record.parentSource != kNoParent && record.parentSource >= header.recordCount)
+			return false;
+
+		for (uint32_t l = 0; l < record.linkCount; l++) {
+			uint32_t link;
+			memcpy(&link, links + (uint64_t(record.firstLink) + l) * sizeof(uint32_t), sizeof(link));
+			if (link >= header.recordCount)
+				return false;
+		}
+	}
+
+	recordCount = header.recordCount;
+	return true;
+}
+
+SnapshotReader::Record SnapshotReader::Get(size_t index) const
+{
+	FileRecord record;
+	memcpy(&record, records + index * sizeof(FileRecord), sizeof(record));
+
+	Record out;
+	out.name = std::string_view(strings + record.name, record.nameLength);
+	out.uuid = std::string_view(strings + record.uuid, record.uuidLength);
+	out.typeId = std::string_view(strings + record.type, record.typeLength);
+	out.classByte = record.classByte;
+	out.vertical = record.vertical != 0;
+	out.parentSource = record.parentSource;
+	// Mapped files are page-aligned and the header and records keep the
+	// link table 4-byte aligned
+	out.parentScenes = reinterpret_cast<const uint32_t *>(links) + record.firstLink;
+	out.parentSceneCount = record.linkCount;
+	return out;
+}
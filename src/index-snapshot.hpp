@@ -0,0 +1,80 @@
+/*
+ * OBS Source Search Plugin
+ * Copyright (C) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Compact binary snapshot of a built collection, one record per row: name,
+// UUID, type ID, class and parent links by record number. The next start
+// re-creates the collection from it by UUID instead of walking every scene
+// and filter. Native byte order; a version bump invalidates old files.
+//
+// Layout: header, fixed-size records, link table (uint32 record numbers),
+// string blob. Every offset is validated when a snapshot is opened, so a
+// truncated or foreign file is simply rejected.
+
+class SnapshotWriter {
+public:
+	static constexpr uint32_t kNoParent = UINT32_MAX;
+
+	// Records are numbered in the order they are added
+	void Add(const std::string &name, const std::string &uuid, const std::string &typeId, uint8_t classByte,
+		 bool vertical, uint32_t parentSource, const std::vector<uint32_t> &parentScenes);
+
+	std::string Finish() const;
+
+private:
+	struct PendingRecord {
+		uint32_t name, nameLength, uuid, uuidLength, type, typeLength;
+		uint32_t parentSource, firstLink, linkCount;
+		uint8_t classByte, vertical;
+	};
+
+	uint32_t Store(const std::string &text);
+
+	std::vector<PendingRecord> records;
+	std::vector<uint32_t> links;
+	std::string strings;
+};
+
+// Read-only view over snapshot bytes (typically a memory-mapped file);
+// the bytes must outlive the reader
+class SnapshotReader {
+public:
+	static constexpr uint32_t kNoParent = SnapshotWriter::kNoParent;
+
+	struct Record {
+		std::string_view name;
+		std::string_view uuid;
+		std::string_view typeId;
+		uint8_t classByte;
+		bool vertical;
+		uint32_t parentSource;  // Filters: record number of the source
+		const uint32_t *parentScenes;
+		uint32_t parentSceneCount;
+	};
+
+	// False if the bytes aren't a well-formed snapshot of this version
+	bool Open(const void *data, size_t size);
+
+	size_t Count() const { return recordCount; }
+	Record Get(size_t index) const;
+
+private:
+	const unsigned char *records = nullptr;
+	const unsigned char *links = nullptr;
+	const char *strings = nullptr;
+	uint32_t recordCount = 0;
+};
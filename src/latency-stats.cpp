@@ -0,0 +1,79 @@
+/*
+ * OBS Source Search Plugin
+ * Copyright (C) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ */
+
+#include "latency-stats.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+void LatencyWindow::Add(uint64_t ns)
+{
+	samples[next] = ns;
+	next = (next + 1) % kWindowSize;
+	if (filled < kWindowSize)
+		filled++;
+}
+
+uint64_t LatencyWindow::Percentile(unsigned percent) const
+{
+	if (filled == 0)
+		return 0;
+
+	std::vector<uint64_t> sorted(samples.begin(), samples.begin() + static_cast<std::ptrdiff_t>(filled));
+	size_t rank = (static_cast<size_t>(std::min(percent, 100u)) * filled + 99) / 100;
+	size_t pos = rank > 0 ? rank - 1 : 0;
+	std::nth_element(sorted.begin(), sorted.begin() + static_cast<std::ptrdiff_t>(pos), sorted.end());
+	return sorted[pos];
+}
+
+void LatencyStats::Record(TimedStage stage, uint64_t ns)
+{
+	windows[static_cast<size_t>(stage)].Add(ns);
+	recorded++;
+}
+
+const char *LatencyStats::StageName(TimedStage stage)
+{
+	switch (stage) {
+	case TimedStage::RefreshEnumerate:
+		return "enumerate";
+	case TimedStage::RefreshFilters:
+		return "filters";
+	case TimedStage::RefreshSceneItems:
+		return "scene items";
+	case TimedStage::RefreshTotal:
+		return "refresh";
+	case TimedStage::Search:
+		return "search";
+	case TimedStage::Populate:
+		return "populate";
+	case TimedStage::Count:
+		break;
+	}
+	return "?";
+}
+
+std::string LatencyStats::Summary() const
+{
+	std::string summary;
+	for (size_t i = 0; i < windows.size(); i++) {
+		const LatencyWindow &window = windows[i];
+		if (window.Samples() == 0)
+			continue;
+
+		char part[96];
+		snprintf(part, sizeof(part), "%s%s %.2f/%.2f ms", summary.empty() ? "" : ", ",
+			 StageName(static_cast<TimedStage>(i)), window.Percentile(50) / 1e6,
+			 window.Percentile(99) / 1e6);
+		summary += part;
+	}
+	return summary;
+}
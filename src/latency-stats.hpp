@@ -0,0 +1,74 @@
+/*
+ * OBS Source Search Plugin
+ * Copyright (C) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ */
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Stages timed by the collection and the dock
+enum class TimedStage : uint8_t {
+	RefreshEnumerate,   // obs_enum_all_sources and AddSource
+	RefreshFilters,     // LinkFilters
+	RefreshSceneItems,  // LinkSceneItems and the nesting closure
+	RefreshTotal,       // Whole build, including the name sort
+	Search,             // Index scan, ranking and item lookup
+	Populate,           // Model reset and status text
+	Count
+};
+
+// Monotonic nanoseconds for interval timing
+inline uint64_t LatencyNow()
+{
+	return static_cast<uint64_t>(
+		std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+			.count());
+}
+
+// Rolling window of the latest samples of one stage
+class LatencyWindow {
+public:
+	void Add(uint64_t ns);
+
+	// Nearest-rank percentile (0-100) over the window, 0 if empty
+	uint64_t Percentile(unsigned percent) const;
+
+	size_t Samples() const { return filled; }
+
+private:
+	static constexpr size_t kWindowSize = 256;
+
+	std::array<uint64_t, kWindowSize> samples{};
+	size_t next = 0;
+	size_t filled = 0;
+};
+
+// Per-stage latency windows (single thread; the dock owns one)
+class LatencyStats {
+public:
+	void Record(TimedStage stage, uint64_t ns);
+
+	const LatencyWindow &Window(TimedStage stage) const { return windows[static_cast<size_t>(stage)]; }
+
+	static const char *StageName(TimedStage stage);
+
+	// "search 0.21/1.40 ms, ..." (p50/p99) for every stage with samples
+	std::string Summary() const;
+
+	// Samples recorded so far, to tell whether anything new happened
+	uint64_t Recorded() const { return recorded; }
+
+private:
+	std::array<LatencyWindow, static_cast<size_t>(TimedStage::Count)> windows;
+	uint64_t recorded = 0;
+};
@@ -0,0 +1,92 @@
+/*
+ * OBS Source Search Plugin
+ * Copyright (C) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+// Bounded lock-free queue for many producers and a single consumer (the
+// per-cell sequence scheme from Dmitry Vyukov's bounded queue). Values are
+// copied in and out, so T should be a small trivially copyable record.
+// Pushing never blocks: a full ring makes TryPush() fail instead.
+template<typename T> class MpscRing {
+	static_assert(std::is_trivially_copyable<T>::value, "MpscRing holds plain records");
+
+public:
+	// Capacity is rounded up to a power of two
+	explicit MpscRing(size_t capacity)
+	{
+		size_t size = 2;
+		while (size < capacity)
+			size <<= 1;
+
+		mask = size - 1;
+		cells.reset(new Cell[size]);
+		for (size_t i = 0; i < size; i++)
+			cells[i].sequence.store(i, std::memory_order_relaxed);
+	}
+
+	MpscRing(const MpscRing &) = delete;
+	MpscRing &operator=(const MpscRing &) = delete;
+
+	// Any thread
+	bool TryPush(const T &value)
+	{
+		Cell *cell;
+		size_t pos = tail.load(std::memory_order_relaxed);
+		for (;;) {
+			cell = &cells[pos & mask];
+			size_t sequence = cell->sequence.load(std::memory_order_acquire);
+			intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+			if (diff == 0) {
+				if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					break;
+			} else if (diff < 0) {
+				return false;  // Full
+			} else {
+				pos = tail.load(std::memory_order_relaxed);
+			}
+		}
+
+		cell->value = value;
+		cell->sequence.store(pos + 1, std::memory_order_release);
+		return true;
+	}
+
+	// Consumer thread only
+	bool TryPop(T &value)
+	{
+		Cell &cell = cells[head & mask];
+		size_t sequence = cell.sequence.load(std::memory_order_acquire);
+		if (static_cast<intptr_t>(sequence) - static_cast<intptr_t>(head + 1) < 0)
+			return false;  // Empty (or a producer hasn't finished writing)
+
+		value = cell.value;
+		cell.sequence.store(head + mask + 1, std::memory_order_release);
+		head++;
+		return true;
+	}
+
+private:
+	struct Cell {
+		std::atomic<size_t> sequence;
+		T value;
+	};
+
+	std::unique_ptr<Cell[]> cells;
+	size_t mask = 0;
+
+	alignas(64) std::atomic<size_t> tail{0};
+	alignas(64) size_t head = 0;
+};
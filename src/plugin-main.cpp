@@ -23,6 +23,7 @@
 #include <QAction>
 
 #include "source-search-dock.hpp"
+#include "websocket-vendor.hpp"
 
 OBS_DECLARE_MODULE()
 OBS_MODULE_USE_DEFAULT_LOCALE("obs-source-search", "en-US")
@@ -69,6 +70,10 @@ static void OnFrontendEvent(enum obs_frontend_event event, void *data)
 			OpenSearchDock,
 			nullptr);
 
+		// Serve remote lookups from the same index
+		SetWebsocketVendorDock(searchDock);
+		RegisterWebsocketVendor();
+
 		// Initialize the dock
 		searchDock->Initialize();
 
@@ -84,8 +89,15 @@ static void OnFrontendEvent(enum obs_frontend_event event, void *data)
 			searchDock->Initialize();
 		}
 
+	} else if (event == OBS_FRONTEND_EVENT_SCENE_LIST_CHANGED) {
+		// Keep (H)/(V) scene markers in sync with the main scene list
+		if (searchDock) {
+			searchDock->OnSceneListChanged();
+		}
+
 	} else if (event == OBS_FRONTEND_EVENT_SCRIPTING_SHUTDOWN) {
 		// Final cleanup
+		UnregisterWebsocketVendor();
 		if (searchDock) {
 			searchDock->Cleanup();
 		}
@@ -116,10 +128,19 @@ bool obs_module_load(void)
 	return true;
 }
 
+void obs_module_post_load(void)
+{
+	// Every module's source and filter types are registered by now
+	CacheTypeDisplayNames();
+}
+
 void obs_module_unload(void)
 {
 	obs_frontend_remove_event_callback(OnFrontendEvent, nullptr);
 
+	// No request may reach the dock once the plugin is going away
+	SetWebsocketVendorDock(nullptr);
+
 	if (searchHotkeyId != OBS_INVALID_HOTKEY_ID) {
 		obs_hotkey_unregister(searchHotkeyId);
 	}
@@ -0,0 +1,73 @@
+/*
+ * OBS Source Search Plugin
+ * Copyright (C) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ */
+
+#include "scan-pool.hpp"
+
+#include <QThread>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+// Under four cores every scan stays on the calling thread
+ScanPool::ScanPool() : helpers(std::clamp(QThread::idealThreadCount() / 4, 0, kMaxHelpers))
+{
+	pool.setMaxThreadCount(std::max(helpers, 1));
+}
+
+ScanPool::~ScanPool()
+{
+	pool.waitForDone();
+}
+
+void ScanPool::Run(size_t count, const std::function<void(size_t)> &task)
+{
+	struct Batch {
+		std::atomic<size_t> next{0};
+		std::mutex mutex;
+		std::condition_variable done;
+		int running = 0;
+	} batch;
+
+	auto work = [&batch, &task, count]() {
+		for (size_t chunk = batch.next++; chunk < count; chunk = batch.next++) {
+			task(chunk);
+		}
+	};
+
+	// Only helpers that can start right away; a busy pool (another scan)
+	// leaves more chunks to this thread
+	int wanted = static_cast<int>(std::min<size_t>(static_cast<size_t>(helpers), count - 1));
+	for (int i = 0; i < wanted; i++) {
+		{
+			std::lock_guard<std::mutex> lock(batch.mutex);
+			batch.running++;
+		}
+
+		bool started = pool.tryStart([&batch, &work]() {
+			work();
+			std::lock_guard<std::mutex> lock(batch.mutex);
+			if (--batch.running == 0)
+				batch.done.notify_one();
+		});
+
+		if (!started) {
+			std::lock_guard<std::mutex> lock(batch.mutex);
+			batch.running--;
+			break;
+		}
+	}
+
+	work();
+
+	std::unique_lock<std::mutex> lock(batch.mutex);
+	batch.done.wait(lock, [&batch]() { return batch.running == 0; });
+}
@@ -0,0 +1,34 @@
+/*
+ * OBS Source Search Plugin
+ * Copyright (C) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ */
+
+#pragma once
+
+#include <QThreadPool>
+
+#include "source-index.hpp"
+
+// Scan executor on its own small QThreadPool. Workers pull the next chunk
+// from a shared counter, so a slow chunk never holds up the others.
+class ScanPool : public ScanExecutor {
+public:
+	// At most this many helper threads, and never more than a quarter of
+	// the cores: the encoders and the render thread come first
+	static constexpr int kMaxHelpers = 3;
+
+	ScanPool();
+	~ScanPool() override;
+
+	size_t Concurrency() const override { return static_cast<size_t>(helpers) + 1; }
+	void Run(size_t count, const std::function<void(size_t)> &task) override;
+
+private:
+	QThreadPool pool;
+	int helpers;
+};
@@ -0,0 +1,197 @@
+/*
+ * OBS Source Search Plugin
+ * Copyright (C) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ */
+
+#include "scene-graph.hpp"
+
+#include <algorithm>
+
+namespace {
+
+enum VisitState : uint8_t {
+	Unvisited,
+	Visiting,
+	Done,
+};
+
+void SetBit(std::vector<uint64_t> &bits, uint32_t bit)
+{
+	size_t word = bit / 64;
+	if (word >= bits.size())
+		bits.resize(word + 1, 0);
+	bits[word] |= uint64_t(1) << (bit % 64);
+}
+
+bool TestBit(const std::vector<uint64_t> &bits, uint32_t bit)
+{
+	size_t word = bit / 64;
+	return word < bits.size() && (bits[word] >> (bit % 64)) & 1;
+}
+
+void OrBits(std::vector<uint64_t> &into, const std::vector<uint64_t> &from)
+{
+	if (from.size() > into.size())
+		into.resize(from.size(), 0);
+	for (size_t i = 0; i < from.size(); i++)
+		into[i] |= from[i];
+}
+
+} // namespace
+
+void SceneGraph::Clear()
+{
+	containers.clear();
+	present.clear();
+	closure.clear();
+	changed.clear();
+	dirty = false;
+}
+
+void SceneGraph::SetContainers(SceneId scene, const std::vector<SceneId> &sceneContainers)
+{
+	// Containers get a slot too, so top-level scenes take part in closures
+	SceneId highest = scene;
+	if (!sceneContainers.empty())
+		highest = std::max(highest, sceneContainers.back());
+	if (highest >= containers.size()) {
+		containers.resize(highest + 1);
+		present.resize(highest + 1, 0);
+	}
+
+	if (present[scene] && containers[scene] == sceneContainers)
+		return;
+
+	present[scene] = 1;
+	containers[scene] = sceneContainers;
+	changed.push_back(scene);
+	dirty = true;
+}
+
+void SceneGraph::RemoveScene(SceneId scene)
+{
+	if (!IsPresent(scene))
+		return;
+
+	present[scene] = 0;
+	containers[scene].clear();
+	changed.push_back(scene);
+	for (SceneId other = 0; other < containers.size(); other++) {
+		auto &list = containers[other];
+		auto pos = std::lower_bound(list.begin(), list.end(), scene);
+		if (pos != list.end() && *pos == scene) {
+			list.erase(pos);
+			changed.push_back(other);
+		}
+	}
+	dirty = true;
+}
+
+void SceneGraph::Update()
+{
+	if (!dirty)
+		return;
+
+	// Only closures that reach a changed scene can change; the rest are
+	// kept and reused (as Done) by the visits. Past a few changes (a full
+	// build) checking every closure costs more than recomputing them all.
+	size_t known = closure.size();
+	bool all = changed.size() * kFullUpdateRatio > containers.size();
+	closure.resize(containers.size());
+
+	std::vector<uint8_t> state(containers.size(), Done);
+	for (SceneId scene = 0; scene < containers.size(); scene++) {
+		bool affected = all || scene >= known;
+		for (size_t i = 0; !affected && i < changed.size(); i++) {
+			affected = changed[i] == scene || TestBit(closure[scene], changed[i]);
+		}
+		if (affected) {
+			closure[scene].clear();
+			state[scene] = Unvisited;
+		}
+	}
+
+	for (SceneId scene = 0; scene < containers.size(); scene++) {
+		Visit(scene, state);
+	}
+
+	changed.clear();
+	dirty = false;
+}
+
+void SceneGraph::Visit(SceneId scene, std::vector<uint8_t> &state)
+{
+	if (state[scene] != Unvisited)
+		return;
+
+	// libobs refuses recursive nesting, but a stale edge must not loop here
+	state[scene] = Visiting;
+
+	Bits &bits = closure[scene];
+	SetBit(bits, scene);
+	for (SceneId container : containers[scene]) {
+		Visit(container, state);
+		if (state[container] == Done)
+			OrBits(bits, closure[container]);
+		else
+			SetBit(bits, container);
+	}
+
+	state[scene] = Done;
+}
+
+void SceneGraph::CollectNested(const std::vector<SceneId> &directParents, std::vector<SceneId> &out) const
+{
+	out.clear();
+
+	// Stale closures could name removed scenes; nothing nested until Update()
+	if (dirty)
+		return;
+
+	Bits visible;
+	for (SceneId parent : directParents) {
+		if (parent < closure.size())
+			OrBits(visible, closure[parent]);
+	}
+
+	for (size_t word = 0; word < visible.size(); word++) {
+		uint64_t bits = visible[word];
+		while (bits) {
+			unsigned offset = 0;
+			while (!((bits >> offset) & 1))
+				offset++;
+			bits &= bits - 1;
+
+			SceneId scene = static_cast<SceneId>(word * 64 + offset);
+			if (!std::binary_search(directParents.begin(), directParents.end(), scene))
+				out.push_back(scene);
+		}
+	}
+}
+
+bool SceneGraph::IsVisibleIn(const std::vector<SceneId> &directParents, SceneId scene) const
+{
+	for (SceneId parent : directParents) {
+		if (parent == scene)
+			return true;
+		if (!dirty && parent < closure.size() && TestBit(closure[parent], scene))
+			return true;
+	}
+	return false;
+}
+
+size_t SceneGraph::MemoryUsage() const
+{
+	size_t bytes = containers.capacity() * sizeof(containers[0]) + present.capacity() +
+		       closure.capacity() * sizeof(Bits);
+	for (const auto &list : containers)
+		bytes += list.capacity() * sizeof(SceneId);
+	for (const auto &bits : closure)
+		bytes += bits.capacity() * sizeof(uint64_t);
+	return bytes;
+}
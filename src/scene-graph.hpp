@@ -0,0 +1,65 @@
+/*
+ * OBS Source Search Plugin
+ * Copyright (C) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Containment graph of scenes and groups, keyed by interned name ID. Each
+// scene records the scenes/groups it is a direct item of; the transitive
+// closure (every scene a scene is ultimately shown in, itself included)
+// is kept as one bitset per scene. Update() recomputes it after edges
+// change, only for the scenes that reach a changed one. Queries never
+// rebuild it, so concurrent readers are safe; until Update() runs they see
+// direct parents only.
+class SceneGraph {
+public:
+	using SceneId = uint32_t;
+
+	void Clear();
+
+	// Replace the direct containers of a scene (sorted IDs)
+	void SetContainers(SceneId scene, const std::vector<SceneId> &containers);
+
+	// Drop a scene and every edge to it
+	void RemoveScene(SceneId scene);
+
+	// Recompute closures after edge changes (with exclusive access)
+	void Update();
+
+	// Scenes (excluding the direct parents themselves) that show an item
+	// only through nesting, given its direct parents; ascending IDs
+	void CollectNested(const std::vector<SceneId> &directParents, std::vector<SceneId> &out) const;
+
+	// True if an item with these direct parents is visible in the scene
+	bool IsVisibleIn(const std::vector<SceneId> &directParents, SceneId scene) const;
+
+	// Approximate heap footprint in bytes
+	size_t MemoryUsage() const;
+
+private:
+	using Bits = std::vector<uint64_t>;
+
+	void Visit(SceneId scene, std::vector<uint8_t> &state);
+
+	bool IsPresent(SceneId scene) const { return scene < present.size() && present[scene]; }
+
+	std::vector<std::vector<SceneId>> containers;  // Direct containers per scene
+	std::vector<uint8_t> present;
+
+	std::vector<Bits> closure;
+	std::vector<SceneId> changed;  // Scenes whose edges changed since Update()
+	bool dirty = false;
+
+	// Update() recomputes everything once over 1/kFullUpdateRatio changed
+	static constexpr size_t kFullUpdateRatio = 8;
+};
@@ -0,0 +1,279 @@
+/*
+ * OBS Source Search Plugin
+ * Copyright (C) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ */
+
+#include "search-matcher.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SEARCH_MATCHER_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define SEARCH_MATCHER_NEON
+#include <arm_neon.h>
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+static inline unsigned CountTrailingZeros(uint64_t mask)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+	unsigned long index;
+	_BitScanForward64(&index, mask);
+	return static_cast<unsigned>(index);
+#else
+	return static_cast<unsigned>(__builtin_ctzll(mask));
+#endif
+}
+
+// Fuzzy scoring weights
+static constexpr int kFuzzyMatch = 16;
+static constexpr int kFuzzyWordStart = 32;
+static constexpr int kFuzzyNameStart = 8;  // On top of kFuzzyWordStart
+static constexpr int kFuzzyConsecutive = 24;
+static constexpr int kFuzzyGap = 1;  // Per skipped byte after the first match
+static constexpr int kFuzzyUnreachable = INT_MIN / 2;
+
+static inline bool IsDigitByte(unsigned char c)
+{
+	return c >= '0' && c <= '9';
+}
+
+static inline bool IsWordByte(unsigned char c)
+{
+	// UTF-8 sequences count as letters
+	return IsDigitByte(c) || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c >= 0x80;
+}
+
+static int WordStartBonus(const char *text, size_t pos)
+{
+	if (pos == 0)
+		return kFuzzyWordStart + kFuzzyNameStart;
+
+	unsigned char prev = static_cast<unsigned char>(text[pos - 1]);
+	unsigned char cur = static_cast<unsigned char>(text[pos]);
+	if (!IsWordByte(cur))
+		return 0;
+	if (!IsWordByte(prev))
+		return kFuzzyWordStart;
+
+	// "cam2": the digit run starts a word of its own, and so on
+	if (IsDigitByte(prev) != IsDigitByte(cur))
+		return kFuzzyWordStart;
+
+	return 0;
+}
+
+std::string FoldSearchText(const std::string &text)
+{
+	std::string folded(text);
+	for (char &c : folded) {
+		if (c >= 'A' && c <= 'Z')
+			c = static_cast<char>(c - 'A' + 'a');
+	}
+	return folded;
+}
+
+std::string MakeSortKey(const std::string &name)
+{
+	std::string key;
+	key.reserve(name.size() * 2 + 1);
+
+	for (size_t i = 0; i < name.size();) {
+		char c = name[i];
+		if (c >= '0' && c <= '9') {
+			// Digit run: skip leading zeros, prefix with its length
+			size_t end = i;
+			while (end < name.size() && name[end] >= '0' && name[end] <= '9')
+				end++;
+			size_t start = i;
+			while (start + 1 < end && name[start] == '0')
+				start++;
+
+			size_t digits = end - start;
+			key += '0';
+			key += static_cast<char>('0' + (digits < 64 ? digits : 64));
+			key.append(name, start, digits);
+			i = end;
+			continue;
+		}
+
+		if (c >= 'A' && c <= 'Z')
+			c = static_cast<char>(c - 'A' + 'a');
+		key += c;
+		i++;
+	}
+
+	// Original spelling breaks ties between names that differ only in case
+	key += '\0';
+	key += name;
+	return key;
+}
+
+bool ContainsFoldedScalar(const char *haystack, size_t haystackLen, const char *needle, size_t needleLen)
+{
+	if (needleLen == 0)
+		return true;
+	if (needleLen > haystackLen)
+		return false;
+
+	// Jump between occurrences of the first byte, then verify the rest
+	const char *p = haystack;
+	const char *last = haystack + (haystackLen - needleLen);
+	while (p <= last) {
+		const void *hit = memchr(p, needle[0], static_cast<size_t>(last - p) + 1);
+		if (!hit)
+			return false;
+
+		p = static_cast<const char *>(hit);
+		if (memcmp(p + 1, needle + 1, needleLen - 1) == 0)
+			return true;
+		p++;
+	}
+
+	return false;
+}
+
+bool ContainsFolded(const char *haystack, size_t haystackLen, const char *needle, size_t needleLen)
+{
+	if (needleLen == 0)
+		return true;
+	if (needleLen > haystackLen)
+		return false;
+	if (needleLen == 1)
+		return memchr(haystack, needle[0], haystackLen) != nullptr;
+
+#if defined(SEARCH_MATCHER_SSE2) || defined(SEARCH_MATCHER_NEON)
+	// Compare 16 candidate positions at once against the needle's first and
+	// last byte; only positions where both match get a memcmp. Every load
+	// is a full 16 bytes inside the haystack, so names shorter than that
+	// take the scalar path.
+	if (haystackLen >= 16) {
+#if defined(SEARCH_MATCHER_SSE2)
+		const __m128i first = _mm_set1_epi8(needle[0]);
+		const __m128i last = _mm_set1_epi8(needle[needleLen - 1]);
+		const unsigned shift = 0;  // Mask bits per lane: 1
+		const uint64_t lane = 0x1;
+		auto laneMask = [](const char *block, __m128i byte) {
+			__m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(block));
+			return static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, byte))));
+		};
+#else
+		const uint8x16_t first = vdupq_n_u8(static_cast<uint8_t>(needle[0]));
+		const uint8x16_t last = vdupq_n_u8(static_cast<uint8_t>(needle[needleLen - 1]));
+		const unsigned shift = 2;  // Mask bits per lane: 4 (no movemask on NEON)
+		const uint64_t lane = 0xF;
+		auto laneMask = [](const char *block, uint8x16_t byte) {
+			uint8x16_t eq = vceqq_u8(vld1q_u8(reinterpret_cast<const uint8_t *>(block)), byte);
+			return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(eq), 4)), 0);
+		};
+#endif
+
+		// Positions base + lane whose first and last byte match
+		auto verify = [&](const char *base, uint64_t mask) {
+			while (mask) {
+				unsigned bit = CountTrailingZeros(mask) >> shift;
+				if (memcmp(base + bit + 1, needle + 1, needleLen - 2) == 0)
+					return true;
+				mask &= ~(lane << (bit << shift));
+			}
+			return false;
+		};
+
+		size_t positions = haystackLen - needleLen + 1;
+		size_t i = 0;
+		for (; i + 16 <= positions; i += 16) {
+			const char *block = haystack + i;
+			if (verify(block, laneMask(block, first) & laneMask(block + needleLen - 1, last)))
+				return true;
+		}
+		if (i == positions)
+			return false;
+
+		// The last positions in one more step (rechecking a few is harmless).
+		// Last bytes come from the haystack's final 16 bytes; in a name
+		// shorter than needle + 15 the first bytes can't line up with them,
+		// so the block at the start is used and the last-byte mask shifted
+		// back by the difference.
+		uint64_t lastMask = laneMask(haystack + haystackLen - 16, last);
+		if (positions >= 16) {
+			const char *block = haystack + positions - 16;
+			return verify(block, laneMask(block, first) & lastMask);
+		}
+		return verify(haystack, laneMask(haystack, first) & (lastMask >> ((16 - positions) << shift)));
+	}
+#endif
+
+	// Short names (or everything without SIMD)
+	return ContainsFoldedScalar(haystack, haystackLen, needle, needleLen);
+}
+
+int FuzzyScore(const char *haystack, size_t haystackLen, const char *needle, size_t needleLen)
+{
+	if (needleLen == 0)
+		return 0;
+	if (needleLen > haystackLen)
+		return kNoFuzzyMatch;
+
+	// Cheap rejection: not a subsequence at all
+	const char *p = haystack;
+	const char *end = haystack + haystackLen;
+	for (size_t i = 0; i < needleLen; i++) {
+		const void *hit = memchr(p, needle[i], static_cast<size_t>(end - p));
+		if (!hit)
+			return kNoFuzzyMatch;
+		p = static_cast<const char *>(hit) + 1;
+	}
+
+	// Best alignment over two DP rows: run[j] is the best score with needle
+	// byte i matched exactly at haystack position j, best[j] the best score
+	// with needle byte i matched anywhere up to j (minus the gap since)
+	thread_local std::vector<int> prevRun, prevBest, run, best;
+	prevRun.assign(haystackLen, kFuzzyUnreachable);
+	prevBest.assign(haystackLen, kFuzzyUnreachable);
+	run.resize(haystackLen);
+	best.resize(haystackLen);
+
+	for (size_t i = 0; i < needleLen; i++) {
+		int bestSoFar = kFuzzyUnreachable;
+		for (size_t j = 0; j < haystackLen; j++) {
+			int score = kFuzzyUnreachable;
+			if (haystack[j] == needle[i]) {
+				int gain = kFuzzyMatch + WordStartBonus(haystack, j);
+				if (i == 0) {
+					// Leading bytes are free
+					score = gain;
+				} else if (j > 0) {
+					if (prevBest[j - 1] > kFuzzyUnreachable)
+						score = prevBest[j - 1] + gain;
+					if (prevRun[j - 1] > kFuzzyUnreachable)
+						score = std::max(score, prevRun[j - 1] + gain + kFuzzyConsecutive);
+				}
+			}
+
+			run[j] = score;
+			if (bestSoFar > kFuzzyUnreachable)
+				bestSoFar -= kFuzzyGap;
+			bestSoFar = std::max(bestSoFar, score);
+			best[j] = bestSoFar;
+		}
+
+		prevRun.swap(run);
+		prevBest.swap(best);
+	}
+
+	int result = prevBest[haystackLen - 1];
+	return result > kFuzzyUnreachable ? result : kNoFuzzyMatch;
+}
@@ -0,0 +1,46 @@
+/*
+ * OBS Source Search Plugin
+ * Copyright (C) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ */
+
+#pragma once
+
+#include <climits>
+#include <cstddef>
+#include <string>
+
+// Substring matching on pre-folded text. Both the needle and the haystack
+// are expected to be folded with FoldSearchText, so the inner loop is a
+// plain byte compare. Folding is ASCII-only (UTF-8 bytes pass through) so
+// results never depend on the C locale.
+
+// Case-fold text for matching
+std::string FoldSearchText(const std::string &text);
+
+// Collation key for ordering names: compares case-insensitively (case only
+// breaks ties) and orders digit runs by value, so "Cam 2" < "Cam 10".
+// Byte-wise comparison of two keys gives the display order.
+std::string MakeSortKey(const std::string &name);
+
+// Find a folded needle in a folded haystack
+bool ContainsFolded(const char *haystack, size_t haystackLen, const char *needle, size_t needleLen);
+
+inline bool ContainsFolded(const std::string &haystack, const std::string &needle)
+{
+	return ContainsFolded(haystack.data(), haystack.size(), needle.data(), needle.size());
+}
+
+// Portable reference implementation (same results as ContainsFolded)
+bool ContainsFoldedScalar(const char *haystack, size_t haystackLen, const char *needle, size_t needleLen);
+
+// Fuzzy subsequence score of a folded needle in a folded haystack. Every
+// needle byte has to appear in order; matches at word starts (after a
+// separator, or where letters and digits meet) and runs of consecutive
+// bytes score higher, skipped bytes cost a little. Higher is better.
+constexpr int kNoFuzzyMatch = INT_MIN;
+int FuzzyScore(const char *haystack, size_t haystackLen, const char *needle, size_t needleLen);
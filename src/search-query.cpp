@@ -0,0 +1,158 @@
+/*
+ * OBS Source Search Plugin
+ * Copyright (C) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ */
+
+#include "search-query.hpp"
+#include "search-matcher.hpp"
+
+#include <cctype>
+
+namespace {
+
+struct Token {
+	std::string key;    // Folded, without the leading '-'
+	std::string value;  // Unquoted
+	std::string raw;    // As typed, for free text
+	bool negated = false;
+	bool hasKey = false;
+};
+
+// Split on spaces outside quotes
+std::vector<Token> Tokenize(const std::string &input)
+{
+	std::vector<Token> tokens;
+	size_t pos = 0;
+
+	while (pos < input.size()) {
+		while (pos < input.size() && input[pos] == ' ')
+			pos++;
+		if (pos >= input.size())
+			break;
+
+		Token token;
+		size_t start = pos;
+		if (input[pos] == '-') {
+			token.negated = true;
+			pos++;
+		}
+
+		// Key: letters and '-' up to a ':'
+		size_t keyStart = pos;
+		while (pos < input.size() && (isalpha(static_cast<unsigned char>(input[pos])) || input[pos] == '-'))
+			pos++;
+		if (pos < input.size() && input[pos] == ':' && pos > keyStart) {
+			token.key = FoldSearchText(input.substr(keyStart, pos - keyStart));
+			token.hasKey = true;
+			pos++;
+		} else {
+			pos = keyStart;
+		}
+
+		// Value, quoted or up to the next space
+		if (pos < input.size() && input[pos] == '"') {
+			size_t close = input.find('"', pos + 1);
+			size_t end = close == std::string::npos ? input.size() : close;
+			token.value = input.substr(pos + 1, end - pos - 1);
+			pos = close == std::string::npos ? input.size() : close + 1;
+		} else {
+			size_t end = input.find(' ', pos);
+			if (end == std::string::npos)
+				end = input.size();
+			token.value = input.substr(pos, end - pos);
+			pos = end;
+		}
+
+		token.raw = input.substr(start, pos - start);
+		tokens.push_back(std::move(token));
+	}
+
+	return tokens;
+}
+
+uint8_t ClassBit(const std::string &name)
+{
+	std::string folded = FoldSearchText(name);
+	if (folded == "source")
+		return SearchQuery::kClassSource;
+	if (folded == "scene")
+		return SearchQuery::kClassScene;
+	if (folded == "group")
+		return SearchQuery::kClassGroup;
+	if (folded == "filter")
+		return SearchQuery::kClassFilter;
+	return 0;
+}
+
+// Apply a term to the query; false if the token is free text
+bool ApplyTerm(const Token &token, SearchQuery &query)
+{
+	if (!token.hasKey) {
+		// Bare -CLASS
+		uint8_t bit = token.negated ? ClassBit(token.value) : 0;
+		query.excludedClasses |= bit;
+		return bit != 0;
+	}
+
+	if (token.value.empty())
+		return false;
+
+	if (token.key == "type") {
+		(token.negated ? query.excludedTypes : query.types).push_back(token.value);
+		return true;
+	}
+
+	if (token.negated)
+		return false;
+
+	if (token.key == "in" || token.key == "scene") {
+		query.scenes.push_back(token.value);
+		return true;
+	}
+
+	if (token.key == "filter-on") {
+		query.filterOn.push_back(token.value);
+		query.classes |= SearchQuery::kClassFilter;
+		return true;
+	}
+
+	if (token.key == "is") {
+		uint8_t bit = ClassBit(token.value);
+		query.classes |= bit;
+		return bit != 0;
+	}
+
+	return false;
+}
+
+} // namespace
+
+SearchQuery ParseSearchQuery(const std::string &input)
+{
+	SearchQuery query;
+	bool anyTerm = false;
+
+	for (const Token &token : Tokenize(input)) {
+		if (ApplyTerm(token, query)) {
+			anyTerm = true;
+			continue;
+		}
+
+		if (!query.text.empty())
+			query.text += ' ';
+		query.text += token.raw.size() >= 2 && token.raw.front() == '"' && token.raw.back() == '"'
+				      ? token.value
+				      : token.raw;
+	}
+
+	// Plain text (spacing included) is searched as typed
+	if (!anyTerm)
+		query.text = input;
+
+	return query;
+}
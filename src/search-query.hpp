@@ -0,0 +1,50 @@
+/*
+ * OBS Source Search Plugin
+ * Copyright (C) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Search box text split into free text and structured terms:
+//
+//   cam type:dshow_input in:"Main Show" -filter
+//
+//   type:ID          item type is ID (several: any of them); -type:ID excludes
+//   in:NAME          shown in scene NAME, directly or nested (scene: is the same)
+//   filter-on:NAME   filters on source NAME (several: any of them)
+//   is:CLASS         only this class (source, scene, group, filter); -CLASS excludes
+//
+// Values may be quoted. Tokens that aren't terms (unknown keys included)
+// are free text; text without any term is kept verbatim.
+struct SearchQuery {
+	// Bits by SourceIndex::ClassByte
+	static constexpr uint8_t kClassSource = 1 << 0;
+	static constexpr uint8_t kClassScene = 1 << 1;
+	static constexpr uint8_t kClassGroup = 1 << 2;
+	static constexpr uint8_t kClassFilter = 1 << 3;
+
+	std::string text;
+	std::vector<std::string> types;
+	std::vector<std::string> excludedTypes;
+	std::vector<std::string> scenes;    // All of them
+	std::vector<std::string> filterOn;  // Any of them
+	uint8_t classes = 0;                // Replaces the scope if set
+	uint8_t excludedClasses = 0;
+
+	// Set by the caller: text also matches indexed setting values
+	bool matchSettings = false;
+
+	// Terms that need the collection's scene and parent names
+	bool HasNameTerms() const { return !scenes.empty() || !filterOn.empty(); }
+};
+
+SearchQuery ParseSearchQuery(const std::string &input);
@@ -0,0 +1,606 @@
+/*
+ * OBS Source Search Plugin
+ * Copyright (C) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ */
+
+#include "source-index.hpp"
+#include "search-matcher.hpp"
+
+#include <algorithm>
+
+namespace {
+
+std::atomic<ScanExecutor *> scanExecutor{nullptr};
+
+// Chunks for a parallel scan over `rows` items, or 0 to scan serially
+size_t ParallelChunks(ScanExecutor *executor, size_t rows)
+{
+	if (!executor || rows < SourceIndex::kParallelMinRows || executor->Concurrency() < 2)
+		return 0;
+	return (rows + SourceIndex::kParallelChunkRows - 1) / SourceIndex::kParallelChunkRows;
+}
+
+// Chunks cover consecutive slices in order, so concatenating their hits
+// in chunk order keeps the serial result order
+template<typename T> void AppendChunks(std::vector<std::vector<T>> &chunks, std::vector<T> &out)
+{
+	size_t total = out.size();
+	for (const auto &chunk : chunks) {
+		total += chunk.size();
+	}
+	out.reserve(total);
+	for (const auto &chunk : chunks) {
+		out.insert(out.end(), chunk.begin(), chunk.end());
+	}
+}
+
+} // namespace
+
+void SourceIndex::SetScanExecutor(ScanExecutor *executor)
+{
+	scanExecutor.store(executor, std::memory_order_release);
+}
+
+void SourceIndex::Clear()
+{
+	nameBlob.clear();
+	nameOffsets.clear();
+	nameLengths.clear();
+	deadNameBytes = 0;
+	settingsBlob.clear();
+	settingsOffsets.clear();
+	settingsLengths.clear();
+	deadSettingsBytes = 0;
+	typeIndexes.clear();
+	classes.clear();
+	flags.clear();
+	liveStates.clear();
+	sortKeys.clear();
+	order.clear();
+	ranks.clear();
+	for (auto &segment : segments) {
+		segment.clear();
+	}
+	segmentRanks.clear();
+	bulkLoading = false;
+	typeIds.clear();
+	trigrams.reset();
+	generation++;
+}
+
+SourceIndex::Row SourceIndex::Add(const std::string &name, const std::string &typeId, uint8_t classByte,
+				  uint8_t rowFlags)
+{
+	Row row = static_cast<Row>(classes.size());
+	std::string searchName = FoldSearchText(name);
+
+	nameOffsets.push_back(static_cast<uint32_t>(nameBlob.size()));
+	nameLengths.push_back(static_cast<uint32_t>(searchName.size()));
+	nameBlob += searchName;
+	settingsOffsets.push_back(0);
+	settingsLengths.push_back(0);
+
+	typeIndexes.push_back(InternType(typeId));
+	classes.push_back(classByte);
+	flags.push_back(rowFlags);
+	liveStates.push_back(0);
+	sortKeys.push_back(MakeSortKey(name));
+	ranks.push_back(0);
+	segmentRanks.push_back(0);
+	generation++;
+
+	if (!bulkLoading)
+		InsertOrdered(row);
+
+	if (trigrams)
+		trigrams->Add(row, nameBlob.data() + nameOffsets[row], nameLengths[row]);
+	else
+		UpdateTrigramMode();
+
+	return row;
+}
+
+void SourceIndex::Remove(Row row)
+{
+	if (row >= classes.size())
+		return;
+
+	deadNameBytes += nameLengths[row];
+	deadSettingsBytes += settingsLengths[row];
+
+	Row last = static_cast<Row>(classes.size() - 1);
+	if (!bulkLoading)
+		EraseOrdered(row);
+
+	if (trigrams) {
+		trigrams->Remove(row, nameBlob.data() + nameOffsets[row], nameLengths[row]);
+		trigrams->Move(last, row, nameBlob.data() + nameOffsets[last], nameLengths[last]);
+	}
+
+	if (row != last) {
+		nameOffsets[row] = nameOffsets[last];
+		nameLengths[row] = nameLengths[last];
+		settingsOffsets[row] = settingsOffsets[last];
+		settingsLengths[row] = settingsLengths[last];
+		typeIndexes[row] = typeIndexes[last];
+		classes[row] = classes[last];
+		flags[row] = flags[last];
+		liveStates[row] = liveStates[last];
+		sortKeys[row] = std::move(sortKeys[last]);
+		ranks[row] = ranks[last];
+		segmentRanks[row] = segmentRanks[last];
+		if (!bulkLoading) {
+			order[ranks[row]] = row;
+			segments[SegmentOf(classes[row])][segmentRanks[row]] = row;
+		}
+	}
+
+	nameOffsets.pop_back();
+	nameLengths.pop_back();
+	settingsOffsets.pop_back();
+	settingsLengths.pop_back();
+	typeIndexes.pop_back();
+	classes.pop_back();
+	flags.pop_back();
+	liveStates.pop_back();
+	sortKeys.pop_back();
+	ranks.pop_back();
+	segmentRanks.pop_back();
+	generation++;
+
+	if (deadNameBytes > nameBlob.size() / 2)
+		CompactNames();
+	if (deadSettingsBytes > settingsBlob.size() / 2)
+		CompactSettings();
+
+	if (trigrams)
+		UpdateTrigramMode();
+}
+
+void SourceIndex::SetName(Row row, const std::string &name)
+{
+	if (row >= classes.size())
+		return;
+
+	std::string searchName = FoldSearchText(name);
+
+	// Re-place the row in the name order
+	if (!bulkLoading)
+		EraseOrdered(row);
+	sortKeys[row] = MakeSortKey(name);
+	if (!bulkLoading)
+		InsertOrdered(row);
+
+	if (trigrams)
+		trigrams->Remove(row, nameBlob.data() + nameOffsets[row], nameLengths[row]);
+
+	// Renames append; the old slice is reclaimed by CompactNames
+	deadNameBytes += nameLengths[row];
+	nameOffsets[row] = static_cast<uint32_t>(nameBlob.size());
+	nameLengths[row] = static_cast<uint32_t>(searchName.size());
+	nameBlob += searchName;
+	generation++;
+
+	if (trigrams)
+		trigrams->Add(row, nameBlob.data() + nameOffsets[row], nameLengths[row]);
+
+	if (deadNameBytes > nameBlob.size() / 2)
+		CompactNames();
+}
+
+void SourceIndex::SetSettingsText(Row row, const std::string &text)
+{
+	if (row >= classes.size())
+		return;
+
+	std::string folded = FoldSearchText(text);
+	if (folded.size() == settingsLengths[row] &&
+	    settingsBlob.compare(settingsOffsets[row], settingsLengths[row], folded) == 0)
+		return;
+
+	deadSettingsBytes += settingsLengths[row];
+	settingsOffsets[row] = static_cast<uint32_t>(settingsBlob.size());
+	settingsLengths[row] = static_cast<uint32_t>(folded.size());
+	settingsBlob += folded;
+	generation++;
+
+	if (deadSettingsBytes > settingsBlob.size() / 2)
+		CompactSettings();
+}
+
+void SourceIndex::ClearSettings()
+{
+	std::string().swap(settingsBlob);
+	std::fill(settingsOffsets.begin(), settingsOffsets.end(), 0);
+	std::fill(settingsLengths.begin(), settingsLengths.end(), 0);
+	deadSettingsBytes = 0;
+	generation++;
+}
+
+void SourceIndex::SetFlag(Row row, uint8_t flag, bool enabled)
+{
+	if (row >= flags.size())
+		return;
+
+	uint8_t updated = enabled ? static_cast<uint8_t>(flags[row] | flag)
+				  : static_cast<uint8_t>(flags[row] & ~flag);
+	if (updated != flags[row]) {
+		flags[row] = updated;
+		generation++;
+	}
+}
+
+uint32_t SourceIndex::FindType(const std::string &typeId) const
+{
+	auto it = typeIds.find(typeId);
+	return it != typeIds.end() ? it->second : kNoType;
+}
+
+uint32_t SourceIndex::InternType(const std::string &typeId)
+{
+	auto it = typeIds.find(typeId);
+	if (it != typeIds.end())
+		return it->second;
+
+	uint32_t id = static_cast<uint32_t>(typeIds.size());
+	typeIds.emplace(typeId, id);
+	return id;
+}
+
+void SourceIndex::CompactNames()
+{
+	std::string compacted;
+	compacted.reserve(nameBlob.size() - deadNameBytes);
+
+	for (size_t row = 0; row < nameOffsets.size(); row++) {
+		uint32_t offset = static_cast<uint32_t>(compacted.size());
+		compacted.append(nameBlob, nameOffsets[row], nameLengths[row]);
+		nameOffsets[row] = offset;
+	}
+
+	nameBlob.swap(compacted);
+	deadNameBytes = 0;
+}
+
+void SourceIndex::CompactSettings()
+{
+	std::string compacted;
+	compacted.reserve(settingsBlob.size() - deadSettingsBytes);
+
+	for (size_t row = 0; row < settingsOffsets.size(); row++) {
+		uint32_t offset = static_cast<uint32_t>(compacted.size());
+		compacted.append(settingsBlob, settingsOffsets[row], settingsLengths[row]);
+		settingsOffsets[row] = offset;
+	}
+
+	settingsBlob.swap(compacted);
+	deadSettingsBytes = 0;
+}
+
+void SourceIndex::SortRows()
+{
+	order.resize(classes.size());
+	for (size_t row = 0; row < order.size(); row++) {
+		order[row] = static_cast<Row>(row);
+	}
+
+	std::sort(order.begin(), order.end(), [this](Row a, Row b) { return sortKeys[a] < sortKeys[b]; });
+
+	for (auto &segment : segments) {
+		segment.clear();
+	}
+	for (size_t rank = 0; rank < order.size(); rank++) {
+		Row row = order[rank];
+		ranks[row] = static_cast<uint32_t>(rank);
+
+		auto &segment = segments[SegmentOf(classes[row])];
+		segmentRanks[row] = static_cast<uint32_t>(segment.size());
+		segment.push_back(row);
+	}
+
+	bulkLoading = false;
+	generation++;
+}
+
+void SourceIndex::InsertOrdered(Row row)
+{
+	auto byKey = [this](Row a, Row b) { return sortKeys[a] < sortKeys[b]; };
+	auto insert = [&](std::vector<Row> &list, std::vector<uint32_t> &positions) {
+		auto pos = std::upper_bound(list.begin(), list.end(), row, byKey);
+		size_t rank = static_cast<size_t>(pos - list.begin());
+		list.insert(pos, row);
+
+		for (size_t i = rank; i < list.size(); i++) {
+			positions[list[i]] = static_cast<uint32_t>(i);
+		}
+	};
+
+	insert(order, ranks);
+	insert(segments[SegmentOf(classes[row])], segmentRanks);
+}
+
+void SourceIndex::EraseOrdered(Row row)
+{
+	auto erase = [](std::vector<Row> &list, std::vector<uint32_t> &positions, size_t rank) {
+		list.erase(list.begin() + static_cast<std::ptrdiff_t>(rank));
+
+		for (size_t i = rank; i < list.size(); i++) {
+			positions[list[i]] = static_cast<uint32_t>(i);
+		}
+	};
+
+	erase(order, ranks, ranks[row]);
+	erase(segments[SegmentOf(classes[row])], segmentRanks, segmentRanks[row]);
+}
+
+void SourceIndex::UpdateTrigramMode()
+{
+	if (!trigrams && classes.size() >= kTrigramThreshold) {
+		trigrams = std::make_unique<TrigramIndex>();
+		for (size_t row = 0; row < classes.size(); row++) {
+			trigrams->Add(static_cast<Row>(row), nameBlob.data() + nameOffsets[row], nameLengths[row]);
+		}
+	} else if (trigrams && classes.size() < kTrigramThreshold / 2) {
+		trigrams.reset();
+	}
+}
+
+bool SourceIndex::RowFilter::operator==(const RowFilter &other) const
+{
+	return classMask == other.classMask && typeAllowed == other.typeAllowed &&
+	       matchSettings == other.matchSettings && hasRowMask == other.hasRowMask &&
+	       (!hasRowMask || rowMask == other.rowMask);
+}
+
+inline bool SourceIndex::RowPasses(size_t row, const RowFilter &filter) const
+{
+	uint8_t classByte = classes[row];
+	if (!(filter.classMask & (1u << classByte)))
+		return false;
+
+	if (flags[row] & FlagRemoved)
+		return false;
+
+	// Skip sources that aren't in any scene (internal OBS sources)
+	// But keep scenes, groups, and filters
+	if (classByte == ClassSource && !(flags[row] & FlagHasParentScene))
+		return false;
+
+	if (!filter.typeAllowed.empty()) {
+		uint32_t typeIndex = typeIndexes[row];
+		if (typeIndex >= filter.typeAllowed.size() || !filter.typeAllowed[typeIndex])
+			return false;
+	}
+
+	if (filter.hasRowMask) {
+		size_t word = row / 64;
+		if (word >= filter.rowMask.size() || !((filter.rowMask[word] >> (row % 64)) & 1))
+			return false;
+	}
+
+	return true;
+}
+
+inline bool SourceIndex::RowNameContains(size_t row, const std::string &foldedText) const
+{
+	return ContainsFolded(nameBlob.data() + nameOffsets[row], nameLengths[row], foldedText.data(),
+			      foldedText.size());
+}
+
+inline bool SourceIndex::RowTextContains(size_t row, const std::string &foldedText, bool matchSettings) const
+{
+	if (RowNameContains(row, foldedText))
+		return true;
+
+	return matchSettings && settingsLengths[row] != 0 &&
+	       ContainsFolded(settingsBlob.data() + settingsOffsets[row], settingsLengths[row], foldedText.data(),
+			      foldedText.size());
+}
+
+void SourceIndex::Match(const std::string &foldedText, const RowFilter &filter, std::vector<Row> &out,
+			const CancelToken &cancel) const
+{
+	// Selective queries on large collections: intersect posting lists,
+	// then verify only those candidates (trigrams cover names only)
+	if (trigrams && !filter.matchSettings && foldedText.size() >= TrigramIndex::kMinQueryLength) {
+		std::vector<Row> candidates;
+		trigrams->Candidates(foldedText.data(), foldedText.size(), candidates);
+
+		size_t first = out.size();
+		for (size_t i = 0; i < candidates.size(); i++) {
+			if (i % kCancelCheckInterval == 0 && cancel.Cancelled())
+				return;
+
+			Row row = candidates[i];
+			if (RowPasses(row, filter) && RowNameContains(row, foldedText))
+				out.push_back(row);
+		}
+
+		// Posting lists are in row order; put the (few) hits in name order
+		// by their precomputed rank
+		std::sort(out.begin() + static_cast<std::ptrdiff_t>(first), out.end(),
+			  [this](Row a, Row b) { return ranks[a] < ranks[b]; });
+		return;
+	}
+
+	const std::vector<Row> &scan = ScanOrder(filter.classMask);
+
+	ScanExecutor *executor = scanExecutor.load(std::memory_order_acquire);
+	size_t chunks = ParallelChunks(executor, scan.size());
+	if (!chunks) {
+		MatchRange(scan, foldedText, filter, 0, scan.size(), out, cancel);
+		return;
+	}
+
+	// Each worker collects into its own chunk's vector
+	std::vector<std::vector<Row>> hits(chunks);
+	executor->Run(chunks, [&](size_t chunk) {
+		size_t begin = chunk * kParallelChunkRows;
+		MatchRange(scan, foldedText, filter, begin, std::min(begin + kParallelChunkRows, scan.size()),
+			   hits[chunk], cancel);
+	});
+	AppendChunks(hits, out);
+}
+
+const std::vector<SourceIndex::Row> &SourceIndex::ScanOrder(uint8_t classMask) const
+{
+	for (size_t segment = 0; segment < kSegmentCount; segment++) {
+		if (!(classMask & ~kSegmentClasses[segment]))
+			return segments[segment];
+	}
+	return order;
+}
+
+void SourceIndex::MatchRange(const std::vector<Row> &scan, const std::string &foldedText, const RowFilter &filter,
+			     size_t begin, size_t end, std::vector<Row> &out, const CancelToken &cancel) const
+{
+	// Walking the presorted order emits matches already sorted by name
+	for (size_t rank = begin; rank < end; rank++) {
+		if (rank % kCancelCheckInterval == 0 && cancel.Cancelled())
+			return;
+
+		Row row = scan[rank];
+		if (RowPasses(row, filter) && RowTextContains(row, foldedText, filter.matchSettings))
+			out.push_back(row);
+	}
+}
+
+void SourceIndex::MatchCandidates(const std::string &foldedText, bool matchSettings,
+				  const std::vector<Row> &candidates, std::vector<Row> &out,
+				  const CancelToken &cancel) const
+{
+	auto checkRange = [&](size_t begin, size_t end, std::vector<Row> &hits) {
+		for (size_t i = begin; i < end; i++) {
+			if (i % kCancelCheckInterval == 0 && cancel.Cancelled())
+				return;
+
+			Row row = candidates[i];
+			if (RowTextContains(row, foldedText, matchSettings))
+				hits.push_back(row);
+		}
+	};
+
+	ScanExecutor *executor = scanExecutor.load(std::memory_order_acquire);
+	size_t chunks = ParallelChunks(executor, candidates.size());
+	if (!chunks) {
+		checkRange(0, candidates.size(), out);
+		return;
+	}
+
+	std::vector<std::vector<Row>> hits(chunks);
+	executor->Run(chunks, [&](size_t chunk) {
+		size_t begin = chunk * kParallelChunkRows;
+		checkRange(begin, std::min(begin + kParallelChunkRows, candidates.size()), hits[chunk]);
+	});
+	AppendChunks(hits, out);
+}
+
+void SourceIndex::MatchFuzzy(const std::string &foldedText, const RowFilter &filter, size_t limit,
+			     std::vector<Row> &out, const CancelToken &cancel) const
+{
+	if (limit == 0)
+		return;
+
+	std::vector<FuzzyHit> heap;
+	const std::vector<Row> &scan = ScanOrder(filter.classMask);
+
+	ScanExecutor *executor = scanExecutor.load(std::memory_order_acquire);
+	size_t chunks = ParallelChunks(executor, scan.size());
+	if (!chunks) {
+		FuzzyRange(scan, foldedText, filter, 0, scan.size(), limit, heap, cancel);
+	} else {
+		// The best `limit` overall are among the best `limit` of each chunk
+		std::vector<std::vector<FuzzyHit>> heaps(chunks);
+		executor->Run(chunks, [&](size_t chunk) {
+			size_t begin = chunk * kParallelChunkRows;
+			FuzzyRange(scan, foldedText, filter, begin, std::min(begin + kParallelChunkRows, scan.size()),
+				   limit, heaps[chunk], cancel);
+		});
+		AppendChunks(heaps, heap);
+	}
+
+	if (cancel.Cancelled())
+		return;
+
+	auto better = [this](const FuzzyHit &a, const FuzzyHit &b) {
+		return a.score != b.score ? a.score > b.score : ranks[a.row] < ranks[b.row];
+	};
+	if (heap.size() > limit) {
+		std::partial_sort(heap.begin(), heap.begin() + static_cast<std::ptrdiff_t>(limit), heap.end(), better);
+		heap.resize(limit);
+	} else {
+		std::sort(heap.begin(), heap.end(), better);
+	}
+
+	out.reserve(out.size() + heap.size());
+	for (const FuzzyHit &hit : heap) {
+		out.push_back(hit.row);
+	}
+}
+
+void SourceIndex::FuzzyRange(const std::vector<Row> &scan, const std::string &foldedText, const RowFilter &filter,
+			     size_t begin, size_t end, size_t limit, std::vector<FuzzyHit> &heap,
+			     const CancelToken &cancel) const
+{
+	// Heap top is the weakest hit kept so far: lowest score, and among
+	// equal scores the last in name order, so every chunk keeps exactly
+	// the rows a single scan would
+	auto weaker = [this](const FuzzyHit &a, const FuzzyHit &b) {
+		return a.score != b.score ? a.score > b.score : ranks[a.row] < ranks[b.row];
+	};
+	heap.reserve(limit);
+
+	// Visiting rows in name order means a later row never beats an equal
+	// score, so a new row only replaces the top with a higher one
+	for (size_t rank = begin; rank < end; rank++) {
+		if (rank % kCancelCheckInterval == 0 && cancel.Cancelled())
+			return;
+
+		Row row = scan[rank];
+		if (!RowPasses(row, filter))
+			continue;
+
+		int score = FuzzyScore(nameBlob.data() + nameOffsets[row], nameLengths[row], foldedText.data(),
+				       foldedText.size());
+		if (score == kNoFuzzyMatch)
+			continue;
+
+		if (heap.size() < limit) {
+			heap.push_back({score, row});
+			std::push_heap(heap.begin(), heap.end(), weaker);
+		} else if (score > heap.front().score) {
+			std::pop_heap(heap.begin(), heap.end(), weaker);
+			heap.back() = {score, row};
+			std::push_heap(heap.begin(), heap.end(), weaker);
+		}
+	}
+}
+
+size_t SourceIndex::MemoryUsage() const
+{
+	size_t bytes = nameBlob.capacity();
+	bytes += nameOffsets.capacity() * sizeof(uint32_t);
+	bytes += nameLengths.capacity() * sizeof(uint32_t);
+	bytes += settingsBlob.capacity();
+	bytes += settingsOffsets.capacity() * sizeof(uint32_t);
+	bytes += settingsLengths.capacity() * sizeof(uint32_t);
+	bytes += typeIndexes.capacity() * sizeof(uint32_t);
+	bytes += classes.capacity() + flags.capacity() + liveStates.capacity() * sizeof(StateByte);
+	bytes += order.capacity() * sizeof(Row) + ranks.capacity() * sizeof(uint32_t);
+	for (const auto &segment : segments) {
+		bytes += segment.capacity() * sizeof(Row);
+	}
+	bytes += segmentRanks.capacity() * sizeof(uint32_t);
+	for (const auto &key : sortKeys) {
+		bytes += sizeof(key) + (key.capacity() > sizeof(key) ? key.capacity() : 0);
+	}
+	for (const auto &[typeId, id] : typeIds) {
+		bytes += typeId.capacity() + sizeof(id) + sizeof(void *) * 2;
+	}
+	return bytes;
+}
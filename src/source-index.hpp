@@ -0,0 +1,291 @@
+/*
+ * OBS Source Search Plugin
+ * Copyright (C) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "trigram-index.hpp"
+
+// Which kinds of items a search returns
+enum class SearchScope : uint8_t {
+	Sources,  // Sources, scenes and groups
+	Filters,
+	All
+};
+
+// How the query is compared with names
+enum class SearchMode : uint8_t {
+	Contains,  // Substring, results in name order
+	Fuzzy      // Subsequence, best scores first
+};
+
+// Lets a scan running on a worker stop early once a newer search has
+// been started (the latest ticket moved on)
+class CancelToken {
+public:
+	CancelToken() = default;
+	CancelToken(const std::atomic<uint64_t> *latestTicket, uint64_t ownTicket)
+		: latest(latestTicket),
+		  ticket(ownTicket)
+	{
+	}
+
+	bool Cancelled() const { return latest && latest->load(std::memory_order_relaxed) != ticket; }
+
+private:
+	const std::atomic<uint64_t> *latest = nullptr;
+	uint64_t ticket = 0;
+};
+
+// Runs independent scan chunks on a few worker threads. The calling
+// thread takes part too, so Run() makes progress even if no worker is free.
+class ScanExecutor {
+public:
+	virtual ~ScanExecutor() = default;
+
+	// Threads a Run() may use, the calling one included
+	virtual size_t Concurrency() const = 0;
+
+	// task(0) .. task(count - 1), each exactly once; returns when all are done
+	virtual void Run(size_t count, const std::function<void(size_t)> &task) = 0;
+};
+
+// Flat, cache-friendly search index kept alongside SourceCollection.
+// Every row mirrors one SourceItem (same position as in the collection's
+// sources vector); all per-row data lives in parallel packed arrays so a
+// search is one linear pass without pointer chasing.
+class SourceIndex {
+public:
+	using Row = uint32_t;
+
+	// Row class byte (matches SourceClass order)
+	enum ClassByte : uint8_t {
+		ClassSource = 0,
+		ClassScene = 1,
+		ClassGroup = 2,
+		ClassFilter = 3
+	};
+
+	// Row flag bits
+	enum Flag : uint8_t {
+		FlagHasParentScene = 1 << 0,
+		FlagRemoved = 1 << 1  // Tombstone: source destroyed, row not yet compacted
+	};
+
+	// Live state bits (shown next to results, never searched)
+	enum LiveState : uint8_t {
+		StateActive = 1 << 0,   // On program or an output
+		StateShowing = 1 << 1,  // Visible anywhere (preview, projector)
+		StateMuted = 1 << 2,
+		StateDisabled = 1 << 3  // Filters: switched off
+	};
+
+	// Rows are also kept in per-scope segments, each in name order, so a
+	// scope scans only its own classes: sources, scenes and groups in one,
+	// filters in the other
+	enum Segment : uint8_t {
+		SegmentItems = 0,
+		SegmentFilters = 1,
+		kSegmentCount = 2
+	};
+	static constexpr uint8_t kSegmentClasses[kSegmentCount] = {
+		(1 << ClassSource) | (1 << ClassScene) | (1 << ClassGroup),
+		1 << ClassFilter,
+	};
+	static Segment SegmentOf(uint8_t classByte) { return classByte == ClassFilter ? SegmentFilters : SegmentItems; }
+
+	static constexpr uint32_t kAnyType = 0xFFFFFFFFu;
+	static constexpr uint32_t kNoType = 0xFFFFFFFEu;
+
+	// Rows at which the trigram index is built (dropped again below half)
+	static constexpr size_t kTrigramThreshold = 5000;
+
+	// Fuzzy searches keep only this many best rows
+	static constexpr size_t kFuzzyResultLimit = 200;
+
+	// Full scans of at least this many rows are split into chunks of
+	// kParallelChunkRows consecutive ranks (their names and metadata fit
+	// in L2) and spread over the scan executor, if one is set
+	static constexpr size_t kParallelMinRows = 32768;
+	static constexpr size_t kParallelChunkRows = 8192;
+
+	// Shared by every index; null scans on the calling thread only
+	static void SetScanExecutor(ScanExecutor *executor);
+
+	// Compiled per-row checks, run before the name is looked at and in
+	// order of cost: class byte, flags, type table, then the row bitset
+	struct RowFilter {
+		uint8_t classMask = 0x0F;          // Bit (1 << ClassByte) per class kept
+		std::vector<uint8_t> typeAllowed;  // Per type index; empty keeps every type
+		std::vector<uint64_t> rowMask;     // Bit per row, if hasRowMask
+		bool hasRowMask = false;
+		bool matchSettings = false;  // Text may also match the row's settings text
+
+		bool operator==(const RowFilter &other) const;
+		bool operator!=(const RowFilter &other) const { return !(*this == other); }
+	};
+
+	void Clear();
+
+	// Append a row (name as displayed; folded and keyed here)
+	Row Add(const std::string &name, const std::string &typeId, uint8_t classByte, uint8_t flags);
+
+	// Remove a row by moving the last row into its place (mirror in the owner)
+	void Remove(Row row);
+
+	void SetName(Row row, const std::string &name);
+
+	// Searchable setting values of a row (deep search), folded and stored
+	// like names; empty until set
+	void SetSettingsText(Row row, const std::string &text);
+	void ClearSettings();
+	size_t SettingsBytes() const { return settingsBlob.size() - deadSettingsBytes; }
+	size_t SettingsLength(Row row) const { return row < settingsLengths.size() ? settingsLengths[row] : 0; }
+
+	// Live state of a row. Not part of any match, so changing it leaves
+	// the generation (and searches reading other rows) alone. Stored
+	// without exclusive access while readers hold the index shared, so
+	// each byte is atomic (rows only move under exclusive access).
+	void SetLiveState(Row row, uint8_t state)
+	{
+		if (row < liveStates.size())
+			liveStates[row].Store(state);
+	}
+	uint8_t LiveState(Row row) const { return row < liveStates.size() ? liveStates[row].Load() : 0; }
+
+	// Bulk loading: Add() skips the incremental ordering until SortRows()
+	// sorts everything once; from then on Add/Remove/SetName keep it up to date
+	void BeginBulkLoad() { bulkLoading = true; }
+	void SortRows();
+	void SetFlag(Row row, uint8_t flag, bool enabled);
+
+	size_t Size() const { return classes.size(); }
+
+	// Bumped by every change; results from an older generation are stale
+	uint64_t Generation() const { return generation; }
+
+	// Interned type IDs (kNoType if the type was never seen)
+	uint32_t FindType(const std::string &typeId) const;
+	size_t TypeCount() const { return typeIds.size(); }
+
+	// Rows between cancellation checks in the scans below; a cancelled
+	// scan returns early with partial results
+	static constexpr size_t kCancelCheckInterval = 1024;
+
+	// Append matching rows to out, in name order
+	void Match(const std::string &foldedText, const RowFilter &filter, std::vector<Row> &out,
+		   const CancelToken &cancel = CancelToken()) const;
+
+	// Re-check only the name of candidate rows from an earlier Match() of
+	// the same generation (for queries that extend the previous one);
+	// keeps the candidates' order
+	void MatchCandidates(const std::string &foldedText, bool matchSettings, const std::vector<Row> &candidates,
+			     std::vector<Row> &out, const CancelToken &cancel = CancelToken()) const;
+
+	// Append the best `limit` fuzzy matches to out, highest score first
+	// (ties in name order); a bounded heap keeps this O(N log limit).
+	// Only names are scored, settings text never is
+	void MatchFuzzy(const std::string &foldedText, const RowFilter &filter, size_t limit, std::vector<Row> &out,
+			const CancelToken &cancel = CancelToken()) const;
+
+	// Approximate heap footprint in bytes
+	size_t MemoryUsage() const;
+	size_t TrigramMemoryUsage() const { return trigrams ? trigrams->MemoryUsage() : 0; }
+	bool HasTrigrams() const { return trigrams != nullptr; }
+
+private:
+	struct FuzzyHit {
+		int score;
+		Row row;
+	};
+
+	// The one segment holding every class of the mask, else the whole order
+	const std::vector<Row> &ScanOrder(uint8_t classMask) const;
+
+	// Serial scans over positions [begin, end) of a name order
+	void MatchRange(const std::vector<Row> &scan, const std::string &foldedText, const RowFilter &filter,
+			size_t begin, size_t end, std::vector<Row> &out, const CancelToken &cancel) const;
+	void FuzzyRange(const std::vector<Row> &scan, const std::string &foldedText, const RowFilter &filter,
+			size_t begin, size_t end, size_t limit, std::vector<FuzzyHit> &heap,
+			const CancelToken &cancel) const;
+
+	// Filter, tombstone and orphan checks for one row
+	bool RowPasses(size_t row, const RowFilter &filter) const;
+	bool RowNameContains(size_t row, const std::string &foldedText) const;
+	bool RowTextContains(size_t row, const std::string &foldedText, bool matchSettings) const;
+
+	// Build or drop the trigram index as the row count crosses the threshold
+	void UpdateTrigramMode();
+
+	// Place a row in / take it out of the name order
+	void InsertOrdered(Row row);
+	void EraseOrdered(Row row);
+
+	uint32_t InternType(const std::string &typeId);
+
+	// Drop name bytes orphaned by renames and removals
+	void CompactNames();
+	void CompactSettings();
+
+	// Contiguous folded names, one [offset, offset + length) slice per row
+	std::string nameBlob;
+	std::vector<uint32_t> nameOffsets;
+	std::vector<uint32_t> nameLengths;
+	size_t deadNameBytes = 0;
+
+	// Folded settings text, same layout as the names
+	std::string settingsBlob;
+	std::vector<uint32_t> settingsOffsets;
+	std::vector<uint32_t> settingsLengths;
+	size_t deadSettingsBytes = 0;
+
+	std::vector<uint32_t> typeIndexes;
+	std::vector<uint8_t> classes;
+	std::vector<uint8_t> flags;
+
+	// Relaxed atomic byte; copyable so it can live in a vector
+	struct StateByte {
+		std::atomic<uint8_t> value;
+
+		StateByte(uint8_t state = 0) : value(state) {}
+		StateByte(const StateByte &other) : value(other.Load()) {}
+		StateByte &operator=(const StateByte &other)
+		{
+			Store(other.Load());
+			return *this;
+		}
+		uint8_t Load() const { return value.load(std::memory_order_relaxed); }
+		void Store(uint8_t state) { value.store(state, std::memory_order_relaxed); }
+	};
+	std::vector<StateByte> liveStates;
+
+	// Persistent name order: order[rank] = row, ranks[row] = rank
+	std::vector<std::string> sortKeys;
+	std::vector<Row> order;
+	std::vector<uint32_t> ranks;
+	std::vector<Row> segments[kSegmentCount];  // Same order, one class group each
+	std::vector<uint32_t> segmentRanks;        // Position in the row's segment
+	bool bulkLoading = false;  // Order is stale until SortRows()
+
+	std::unordered_map<std::string, uint32_t> typeIds;
+
+	// Only present for large collections
+	std::unique_ptr<TrigramIndex> trigrams;
+
+	uint64_t generation = 0;
+};
@@ -11,8 +11,8 @@
 #include "source-item.hpp"
 
 #include <algorithm>
-#include <cctype>
 #include <cstring>
+#include <unordered_map>
 
 // Known source type display names (fallback if OBS doesn't provide one)
 const std::map<std::string, std::string> SOURCE_TYPE_NAMES = {
@@ -42,30 +42,15 @@ const std::map<std::string, std::string> SOURCE_TYPE_NAMES = {
 	{"obs_stinger_transition", "Stinger"},
 };
 
-// Helper: case-insensitive string contains
-static bool ContainsCaseInsensitive(const std::string &haystack, const std::string &needle)
-{
-	if (needle.empty())
-		return true;
-	if (haystack.empty())
-		return false;
-
-	auto it = std::search(
-		haystack.begin(), haystack.end(),
-		needle.begin(), needle.end(),
-		[](char a, char b) {
-			return std::tolower(static_cast<unsigned char>(a)) ==
-			       std::tolower(static_cast<unsigned char>(b));
-		});
-
-	return it != haystack.end();
-}
-
 // SourceItem implementation
 
 SourceItem::SourceItem(obs_source_t *source)
 	: weakSource(nullptr),
-	  sourceClass(SourceClass::Source)
+	  sourceClass(SourceClass::Source),
+	  parentSourceId(kNoNameId),
+	  nameId(kNoNameId),
+	  indexRow(0),
+	  verticalCanvas(false)
 {
 	if (!source)
 		return;
@@ -87,6 +72,29 @@ SourceItem::SourceItem(obs_source_t *source)
 	if (typeId) {
 		cachedTypeId = typeId;
 	}
+
+	// Cache name and UUID
+	const char *sourceName = obs_source_get_name(source);
+	SetName(sourceName ? sourceName : "");
+
+	const char *sourceUuid = obs_source_get_uuid(source);
+	if (sourceUuid) {
+		uuid = sourceUuid;
+	}
+}
+
+SourceItem::SourceItem(SourceClass itemClass, std::string_view itemName, std::string_view itemUuid,
+		       std::string_view itemTypeId)
+	: weakSource(nullptr),
+	  sourceClass(itemClass),
+	  parentSourceId(kNoNameId),
+	  nameId(kNoNameId),
+	  uuid(itemUuid),
+	  cachedTypeId(itemTypeId),
+	  indexRow(0),
+	  verticalCanvas(false)
+{
+	SetName(std::string(itemName));
 }
 
 SourceItem::~SourceItem()
@@ -96,21 +104,14 @@ SourceItem::~SourceItem()
 	}
 }
 
-std::string SourceItem::GetName() const
+void SourceItem::SetName(const std::string &newName)
 {
-	obs_source_t *source = GetSource();
-	if (!source)
-		return "";
-
-	const char *name = obs_source_get_name(source);
-	std::string result = name ? name : "";
-	obs_source_release(source);
-	return result;
+	name = newName;
+	searchName = FoldSearchText(newName);
 }
 
 std::string SourceItem::GetDisplayName() const
 {
-	std::string name = GetName();
 	if (name.empty())
 		return name;
 
@@ -123,18 +124,6 @@ std::string SourceItem::GetDisplayName() const
 	return name;
 }
 
-std::string SourceItem::GetUUID() const
-{
-	obs_source_t *source = GetSource();
-	if (!source)
-		return "";
-
-	const char *uuid = obs_source_get_uuid(source);
-	std::string result = uuid ? uuid : "";
-	obs_source_release(source);
-	return result;
-}
-
 std::string SourceItem::GetTypeId() const
 {
 	return cachedTypeId;
@@ -147,44 +136,24 @@ std::string SourceItem::GetTypeDisplayName() const
 
 obs_source_t *SourceItem::GetSource() const
 {
+	// Restored items find their source by UUID, only when asked for it
 	if (!weakSource)
-		return nullptr;
+		return uuid.empty() ? nullptr : obs_get_source_by_uuid(uuid.c_str());
 	return obs_weak_source_get_source(weakSource);
 }
 
-void SourceItem::AddParentScene(const std::string &sceneName)
+void SourceItem::AddParentScene(uint32_t sceneId)
 {
-	parentScenes.insert(sceneName);
+	auto pos = std::lower_bound(parentScenes.begin(), parentScenes.end(), sceneId);
+	if (pos == parentScenes.end() || *pos != sceneId)
+		parentScenes.insert(pos, sceneId);
 }
 
-bool SourceItem::IsVerticalCanvas() const
+void SourceItem::RemoveParentScene(uint32_t sceneId)
 {
-	// Only scenes can be on vertical canvas
-	if (sourceClass != SourceClass::Scene)
-		return false;
-
-	obs_source_t *source = GetSource();
-	if (!source)
-		return false;
-
-	// Get the main scene list
-	struct obs_frontend_source_list mainScenes = {};
-	obs_frontend_get_scenes(&mainScenes);
-
-	// Check if this scene is in the main list
-	bool isMainScene = false;
-	for (size_t i = 0; i < mainScenes.sources.num; i++) {
-		if (mainScenes.sources.array[i] == source) {
-			isMainScene = true;
-			break;
-		}
-	}
-
-	obs_frontend_source_list_free(&mainScenes);
-	obs_source_release(source);
-
-	// If it's a scene but not in main scenes, it's from vertical canvas
-	return !isMainScene;
+	auto pos = std::lower_bound(parentScenes.begin(), parentScenes.end(), sceneId);
+	if (pos != parentScenes.end() && *pos == sceneId)
+		parentScenes.erase(pos);
 }
 
 bool SourceItem::MatchesSearch(const std::string &searchText) const
@@ -193,7 +162,7 @@ bool SourceItem::MatchesSearch(const std::string &searchText) const
 		return true;
 
 	// Match against name only
-	if (ContainsCaseInsensitive(GetName(), searchText))
+	if (ContainsFolded(searchName, searchText))
 		return true;
 
 	return false;
@@ -229,95 +198,167 @@ SourceCollection::~SourceCollection()
 void SourceCollection::Clear()
 {
 	sources.clear();
+	tombstones.clear();
+	removedSources.clear();
 	sourcesByUUID.clear();
-	discoveredTypes.clear();
+	types.Clear();
+	mainSceneUUIDs.clear();
+	internedNames.clear();
+	filtersByParent.clear();
+	nameArena.Clear();
+	storedNameBytes = 0;
+	deadNameBytes = 0;
+	sceneGraph.Clear();
+	index.Clear();
+	lastSearch.Reset();
+	nameTermsKey.clear();
+	settingsIndexed = false;
+	settingsOverLimit = 0;
 }
 
 void SourceCollection::Refresh()
 {
+	// Snapshot the main scene list once instead of per scene row
+	Refresh(CaptureMainScenes());
+}
+
+void SourceCollection::Refresh(std::unordered_set<std::string> mainScenes)
+{
+	uint64_t start = LatencyNow();
+
 	Clear();
+	mainSceneUUIDs = std::move(mainScenes);
+
+	index.BeginBulkLoad();
+
+	// Enumerate all sources (this includes VC scenes but NOT filters).
+	// Take strong references first so nothing disappears while we build,
+	// and so libobs' source list isn't locked during the heavier work below
+	std::vector<obs_source_t *> liveSources;
+	obs_enum_all_sources(EnumAllSourcesCallback, &liveSources);
 
-	// Enumerate all sources (this includes VC scenes but NOT filters)
-	obs_enum_all_sources(EnumAllSourcesCallback, this);
+	for (obs_source_t *source : liveSources) {
+		SourceItem *item = AddSource(source);
+		// Scenes first, so their IDs (and the graph's bitsets) stay dense
+		if (item && (item->IsScene() || item->IsGroup()))
+			InternName(item);
+	}
+	uint64_t enumerated = LatencyNow();
 
 	// Enumerate filters on each source and link them
 	LinkFilters();
+	uint64_t filtersLinked = LatencyNow();
 
-	// Link scene items to their parent scenes
+	// Link scene items to their parent scenes, then resolve nesting once
 	LinkSceneItems();
+	sceneGraph.Update();
+	uint64_t sceneItemsLinked = LatencyNow();
+
+	// Sort once after bulk loading; deltas keep the order from here on
+	index.SortRows();
 
-	blog(LOG_INFO, "[Source Search] Refreshed: found %zu sources, %zu types",
-	     sources.size(), discoveredTypes.size());
+	for (obs_source_t *source : liveSources) {
+		obs_source_release(source);
+	}
+
+	refreshTimings.enumerate = enumerated - start;
+	refreshTimings.filters = filtersLinked - enumerated;
+	refreshTimings.sceneItems = sceneItemsLinked - filtersLinked;
+	refreshTimings.total = LatencyNow() - start;
+
+	blog(LOG_INFO,
+	     "[Source Search] Refreshed: found %zu sources, %zu types, index %zu KB, trigrams %s (%zu KB), "
+	     "%zu parent names (%zu KB), scene graph %zu KB",
+	     sources.size(), types.Size(), index.MemoryUsage() / 1024,
+	     index.HasTrigrams() ? "on" : "off", index.TrigramMemoryUsage() / 1024, internedNames.size(),
+	     nameArena.MemoryUsage() / 1024, sceneGraph.MemoryUsage() / 1024);
+	blog(LOG_INFO, "[Source Search] Refresh took %.1f ms (enumerate %.1f, filters %.1f, scene items %.1f)",
+	     refreshTimings.total / 1e6, refreshTimings.enumerate / 1e6, refreshTimings.filters / 1e6,
+	     refreshTimings.sceneItems / 1e6);
 }
 
 bool SourceCollection::EnumAllSourcesCallback(void *param, obs_source_t *source)
 {
-	SourceCollection *self = static_cast<SourceCollection *>(param);
-	self->AddSource(source);
+	auto *liveSources = static_cast<std::vector<obs_source_t *> *>(param);
+	obs_source_t *ref = obs_source_get_ref(source);
+	if (ref)
+		liveSources->push_back(ref);
 	return true;
 }
 
-void SourceCollection::AddSource(obs_source_t *source)
+SourceItem *SourceCollection::AddSource(obs_source_t *source)
 {
 	if (!source)
-		return;
+		return nullptr;
 
 	// Skip filters - they'll be added separately with parent info
 	// Skip transitions - they're internal OBS sources
 	obs_source_type type = obs_source_get_type(source);
 	if (type == OBS_SOURCE_TYPE_FILTER || type == OBS_SOURCE_TYPE_TRANSITION)
-		return;
+		return nullptr;
 
 	// Skip sources without names
 	const char *name = obs_source_get_name(source);
 	if (!name || strlen(name) == 0)
-		return;
+		return nullptr;
 
 	// Get type ID for filtering
 	const char *typeId = obs_source_get_id(source);
 	if (!typeId)
-		return;
+		return nullptr;
 
 	// Skip internal OBS sources
 	if (strcmp(typeId, "audio_monitor") == 0) {
 		blog(LOG_INFO, "[Source Search] Skipping audio_monitor: %s", name);
-		return;
+		return nullptr;
 	}
 
 	// Skip internal wrapper sources (from plugins like Vertical Canvas)
 	if (strstr(typeId, "_wrapper_") != nullptr)
-		return;
+		return nullptr;
 
 	// Skip stinger transition media sources (they have "(Stinger)" suffix)
 	if (strstr(name, "(Stinger)") != nullptr)
-		return;
+		return nullptr;
 
 	// Skip audio line sources (internal)
 	if (strcmp(typeId, "audio_line") == 0)
-		return;
+		return nullptr;
 
 	// Check for duplicates by UUID
 	const char *uuid = obs_source_get_uuid(source);
 	if (uuid && sourcesByUUID.find(uuid) != sourcesByUUID.end()) {
-		return;
+		return nullptr;
 	}
 
 	// Create source item
 	auto item = std::make_unique<SourceItem>(source);
 	if (!item->IsValid())
-		return;
+		return nullptr;
+
+	// Only scenes can be on vertical canvas; a scene that isn't in the
+	// main scene list is from vertical canvas
+	if (item->IsScene())
+		item->SetVerticalCanvas(!uuid || mainSceneUUIDs.count(uuid) == 0);
 
+	SourceItem *added = StoreItem(std::move(item));
+	index.SetLiveState(added->GetIndexRow(), ReadLiveState(source));
+	return added;
+}
+
+SourceItem *SourceCollection::StoreItem(std::unique_ptr<SourceItem> item)
+{
 	// Track discovered type
-	std::string typeIdStr = typeId;
-	if (discoveredTypes.find(typeIdStr) == discoveredTypes.end()) {
-		discoveredTypes[typeIdStr] = GetTypeDisplayName(typeIdStr);
-	}
+	std::string typeId = item->GetTypeId();
+	types.Add(typeId);
 
 	// Add to collections
-	if (uuid) {
-		sourcesByUUID[uuid] = item.get();
-	}
+	SourceItem *added = item.get();
+	added->SetIndexRow(index.Add(added->GetName(), typeId, static_cast<uint8_t>(added->GetSourceClass()), 0));
+	if (!added->GetUUID().empty())
+		sourcesByUUID[added->GetUUID()] = added;
 	sources.push_back(std::move(item));
+	return added;
 }
 
 void SourceCollection::LinkFilters()
@@ -330,156 +371,850 @@ void SourceCollection::LinkFilters()
 	}
 
 	for (SourceItem *item : sourcesToEnumerate) {
-		obs_source_t *source = item->GetSource();
-		if (!source)
-			continue;
+		LinkFiltersFor(item);
+	}
+}
 
-		std::string parentName = item->GetName();
+void SourceCollection::LinkFiltersFor(SourceItem *item)
+{
+	if (item->IsFilter())
+		return;
 
-		// Enumerate filters on this source
-		struct FilterEnumContext {
-			SourceCollection *self;
-			std::string parentName;
-		};
-		FilterEnumContext ctx = {this, parentName};
+	obs_source_t *source = item->GetSource();
+	if (!source)
+		return;
 
-		obs_source_enum_filters(
-			source,
-			[](obs_source_t *, obs_source_t *filter, void *param) {
-				FilterEnumContext *ctx = static_cast<FilterEnumContext *>(param);
-				ctx->self->AddFilter(filter, ctx->parentName);
-			},
-			&ctx);
+	// Enumerate filters on this source
+	struct FilterEnumContext {
+		SourceCollection *self;
+		SourceItem *parent;
+	};
+	FilterEnumContext ctx = {this, item};
+
+	obs_source_enum_filters(
+		source,
+		[](obs_source_t *, obs_source_t *filter, void *param) {
+			FilterEnumContext *ctx = static_cast<FilterEnumContext *>(param);
+			ctx->self->AddFilter(filter, ctx->parent);
+		},
+		&ctx);
 
-		obs_source_release(source);
-	}
+	obs_source_release(source);
 }
 
-void SourceCollection::AddFilter(obs_source_t *filter, const std::string &parentName)
+SourceItem *SourceCollection::AddFilter(obs_source_t *filter, SourceItem *parent)
 {
-	if (!filter)
-		return;
+	if (!filter || !parent)
+		return nullptr;
 
 	const char *name = obs_source_get_name(filter);
 	if (!name || strlen(name) == 0)
-		return;
+		return nullptr;
 
 	const char *typeId = obs_source_get_id(filter);
 	if (!typeId)
-		return;
+		return nullptr;
 
 	// Skip internal filter types
 	if (strcmp(typeId, "audio_monitor") == 0)
-		return;
+		return nullptr;
 
 	// Check for duplicates by UUID
 	const char *uuid = obs_source_get_uuid(filter);
 	if (uuid && sourcesByUUID.find(uuid) != sourcesByUUID.end()) {
-		return;
+		return nullptr;
 	}
 
 	// Create filter item
 	auto item = std::make_unique<SourceItem>(filter);
 	if (!item->IsValid())
-		return;
+		return nullptr;
 
-	// Set parent source name
-	item->SetParentSourceName(parentName);
+	SourceItem *added = StoreFilter(std::move(item), parent);
+	index.SetLiveState(added->GetIndexRow(), ReadLiveState(filter));
+	return added;
+}
 
-	// Track discovered type
-	std::string typeIdStr = typeId;
-	if (discoveredTypes.find(typeIdStr) == discoveredTypes.end()) {
-		discoveredTypes[typeIdStr] = GetTypeDisplayName(typeIdStr);
-	}
+SourceItem *SourceCollection::StoreFilter(std::unique_ptr<SourceItem> item, SourceItem *parent)
+{
+	// Refer to the parent by its interned name
+	uint32_t parentId = InternName(parent);
+	item->SetParentSourceId(parentId);
 
-	// Add to collections
-	if (uuid) {
-		sourcesByUUID[uuid] = item.get();
-	}
-	sources.push_back(std::move(item));
+	SourceItem *added = StoreItem(std::move(item));
+
+	// Reverse link, so the filters on a source never need a full scan
+	if (filtersByParent.size() <= parentId)
+		filtersByParent.resize(parentId + 1);
+	filtersByParent[parentId].push_back(added);
+	return added;
 }
 
 void SourceCollection::LinkSceneItems()
 {
 	// For each scene (main and vertical), enumerate items and link them
 	for (auto &item : sources) {
-		if (!item->IsScene() && !item->IsGroup())
+		if (item->IsScene() || item->IsGroup())
+			LinkSceneItemsFor(item.get());
+	}
+}
+
+void SourceCollection::LinkSceneItemsFor(SourceItem *sceneItem)
+{
+	obs_source_t *source = sceneItem->GetSource();
+	if (!source)
+		return;
+
+	obs_scene_t *scene = SceneFromSource(source);
+	if (!scene) {
+		obs_source_release(source);
+		return;
+	}
+
+	// Enumerate scene items (groups are scenes too; nesting beyond the
+	// direct children is resolved by the scene graph)
+	struct EnumContext {
+		SourceCollection *self;
+		uint32_t sceneId;
+	};
+	EnumContext ctx = {this, InternName(sceneItem)};
+
+	obs_scene_enum_items(scene,
+		[](obs_scene_t *, obs_sceneitem_t *sceneItem, void *param) {
+			EnumContext *ctx = static_cast<EnumContext *>(param);
+
+			obs_source_t *itemSource = obs_sceneitem_get_source(sceneItem);
+			if (!itemSource)
+				return true;
+
+			// Link source to parent scene
+			const char *uuid = obs_source_get_uuid(itemSource);
+			if (uuid) {
+				auto it = ctx->self->sourcesByUUID.find(uuid);
+				if (it != ctx->self->sourcesByUUID.end()) {
+					ctx->self->AddParentScene(it->second, ctx->sceneId);
+				}
+			}
+
+			return true;
+		},
+		&ctx);
+
+	obs_source_release(source);
+}
+
+obs_scene_t *SourceCollection::SceneFromSource(obs_source_t *source)
+{
+	if (!source)
+		return nullptr;
+
+	obs_scene_t *scene = obs_scene_from_source(source);
+	if (!scene)
+		scene = obs_group_from_source(source);
+	return scene;
+}
+
+bool SourceCollection::SceneContains(obs_scene_t *scene, obs_source_t *target)
+{
+	if (!scene || !target)
+		return false;
+
+	struct ContainsContext {
+		obs_source_t *target;
+		bool found;
+	};
+	ContainsContext ctx = {target, false};
+
+	obs_scene_enum_items(scene,
+		[](obs_scene_t *, obs_sceneitem_t *sceneItem, void *param) {
+			ContainsContext *ctx = static_cast<ContainsContext *>(param);
+			if (obs_sceneitem_get_source(sceneItem) == ctx->target) {
+				ctx->found = true;
+				return false;
+			}
+			return true;
+		},
+		&ctx);
+
+	return ctx.found;
+}
+
+bool SourceCollection::RelinkSceneItem(obs_source_t *scene, obs_source_t *item)
+{
+	if (!scene || !item)
+		return false;
+
+	const char *sceneUuid = obs_source_get_uuid(scene);
+	const char *itemUuid = obs_source_get_uuid(item);
+	if (!sceneUuid || !itemUuid)
+		return false;
+
+	SourceItem *sceneItem = FindByUUID(sceneUuid);
+	SourceItem *member = FindByUUID(itemUuid);
+	if (!sceneItem || !member || member->IsFilter())
+		return false;
+
+	// The scene may hold several items of the same source, so ask the
+	// scene rather than trusting the single add/remove that got us here
+	uint32_t sceneId = InternName(sceneItem);
+	bool contained = SceneContains(SceneFromSource(scene), item);
+
+	const auto &parents = member->GetParentScenes();
+	bool linked = std::binary_search(parents.begin(), parents.end(), sceneId);
+	if (contained == linked)
+		return false;
+
+	if (contained) {
+		AddParentScene(member, sceneId);
+	} else {
+		member->RemoveParentScene(sceneId);
+		SyncParents(member);
+	}
+
+	// Recompute nesting while the caller holds the collection exclusively,
+	// so concurrent readers never rebuild it
+	sceneGraph.Update();
+	return true;
+}
+
+bool SourceCollection::InsertSource(obs_source_t *source)
+{
+	if (!source)
+		return false;
+
+	// Filters are attached to their parent after creation; pick them up
+	// only once the parent is known and tracked
+	if (obs_source_get_type(source) == OBS_SOURCE_TYPE_FILTER) {
+		obs_source_t *parent = obs_filter_get_parent(source);
+		if (!parent)
+			return false;
+
+		const char *parentUuid = obs_source_get_uuid(parent);
+		if (!parentUuid)
+			return false;
+
+		auto it = sourcesByUUID.find(parentUuid);
+		if (it == sourcesByUUID.end())
+			return false;
+
+		return AddFilter(source, it->second) != nullptr;
+	}
+
+	// A new scene may already be in the frontend list; re-snapshot so its
+	// (H)/(V) flag is right even if the scene list event came first
+	if (obs_source_is_scene(source))
+		mainSceneUUIDs = CaptureMainScenes();
+
+	SourceItem *item = AddSource(source);
+	if (!item)
+		return false;
+
+	LinkFiltersFor(item);
+	if (item->IsScene() || item->IsGroup())
+		LinkSceneItemsFor(item);
+
+	// Scenes that show it are not searched here: adding it to a scene
+	// fires item_add on that scene (watched since the scene was tracked),
+	// whose SceneItem delta is drained after this one and relinks it
+
+	// Linking may have added nesting edges; recompute under the caller's
+	// exclusive hold, like RelinkSceneItem
+	sceneGraph.Update();
+	return true;
+}
+
+bool SourceCollection::RemoveSource(const std::string &uuid)
+{
+	auto it = sourcesByUUID.find(uuid);
+	if (it == sourcesByUUID.end())
+		return false;
+
+	SourceItem *item = it->second;
+	sourcesByUUID.erase(it);
+
+	// Tombstone the row so searches skip it right away; the rest of the
+	// cleanup is batched in PurgeRemoved()
+	index.SetFlag(item->GetIndexRow(), SourceIndex::FlagRemoved, true);
+	tombstones.push_back(item);
+
+	return true;
+}
+
+void SourceCollection::PurgeRemoved()
+{
+	if (tombstones.empty())
+		return;
+
+	// Scenes going away no longer count as a parent of their members
+	std::vector<uint32_t> removedScenes;
+	for (SourceItem *item : tombstones) {
+		if ((item->IsScene() || item->IsGroup()) && item->GetNameId() != SourceItem::kNoNameId) {
+			removedScenes.push_back(item->GetNameId());
+			sceneGraph.RemoveScene(item->GetNameId());
+		}
+	}
+
+	if (!removedScenes.empty()) {
+		for (auto &member : sources) {
+			if (member->GetParentScenes().empty())
+				continue;
+			for (uint32_t sceneId : removedScenes) {
+				member->RemoveParentScene(sceneId);
+			}
+			SyncParents(member.get());
+		}
+	}
+
+	for (SourceItem *item : tombstones) {
+		types.Release(item->GetTypeId());
+
+		if (item->IsFilter() && item->GetParentSourceId() < filtersByParent.size()) {
+			auto &siblings = filtersByParent[item->GetParentSourceId()];
+			siblings.erase(std::remove(siblings.begin(), siblings.end(), item), siblings.end());
+		}
+
+		// Swap the last row into this slot, mirroring SourceIndex::Remove
+		SourceIndex::Row row = item->GetIndexRow();
+		SourceIndex::Row lastRow = static_cast<SourceIndex::Row>(sources.size() - 1);
+		index.Remove(row);
+		if (row != lastRow) {
+			std::swap(sources[row], sources[lastRow]);
+			sources[row]->SetIndexRow(row);
+		}
+
+		// Keep the item alive until the results list has been rebuilt
+		removedSources.push_back(std::move(sources.back()));
+		sources.pop_back();
+	}
+
+	tombstones.clear();
+	sceneGraph.Update();
+}
+
+bool SourceCollection::RenameSource(obs_source_t *source)
+{
+	if (!source)
+		return false;
+
+	const char *uuid = obs_source_get_uuid(source);
+	if (!uuid)
+		return false;
+
+	auto it = sourcesByUUID.find(uuid);
+	if (it == sourcesByUUID.end()) {
+		// Sources skipped while unnamed may qualify now
+		return InsertSource(source);
+	}
+
+	const char *newName = obs_source_get_name(source);
+	SourceItem *item = it->second;
+	if (!newName || item->GetName() == newName)
+		return false;
+
+	item->SetName(newName);
+	index.SetName(item->GetIndexRow(), item->GetName());
+
+	// Members and filters refer to this item by name ID, so repointing the
+	// interned entry renames it everywhere. The old bytes are reclaimed by
+	// CompactInternedNames.
+	if (item->GetNameId() != SourceItem::kNoNameId) {
+		std::string_view &interned = internedNames[item->GetNameId()];
+		deadNameBytes += interned.size();
+		interned = StoreInternedName(item->GetName());
+		if (deadNameBytes > storedNameBytes / 2)
+			CompactInternedNames();
+	}
+
+	return true;
+}
+
+std::string SourceCollection::SaveSnapshot() const
+{
+	// Records follow row order; name IDs become record numbers
+	std::vector<uint32_t> recordOfName(internedNames.size(), SnapshotWriter::kNoParent);
+	for (const auto &item : sources) {
+		if (item->GetNameId() != SourceItem::kNoNameId)
+			recordOfName[item->GetNameId()] = item->GetIndexRow();
+	}
+
+	auto toRecord = [&](uint32_t nameId) {
+		return nameId < recordOfName.size() ? recordOfName[nameId] : SnapshotWriter::kNoParent;
+	};
+
+	SnapshotWriter writer;
+	std::vector<uint32_t> parents;
+	for (const auto &item : sources) {
+		parents.clear();
+		for (uint32_t sceneId : item->GetParentScenes()) {
+			uint32_t record = toRecord(sceneId);
+			if (record != SnapshotWriter::kNoParent)
+				parents.push_back(record);
+		}
+
+		uint32_t parentSource = item->IsFilter() ? toRecord(item->GetParentSourceId()) : SnapshotWriter::kNoParent;
+		writer.Add(item->GetName(), item->GetUUID(), item->GetTypeId(),
+			   static_cast<uint8_t>(item->GetSourceClass()), item->IsVerticalCanvas(), parentSource, parents);
+	}
+
+	return writer.Finish();
+}
+
+bool SourceCollection::LoadSnapshot(const SnapshotReader &snapshot)
+{
+	uint64_t start = LatencyNow();
+
+	Clear();
+	index.BeginBulkLoad();
+
+	// Rows come straight from the records; live state stays clear until
+	// the live build replaces them
+	std::vector<SourceItem *> byRecord(snapshot.Count(), nullptr);
+	auto restore = [&](const SnapshotReader::Record &record) -> std::unique_ptr<SourceItem> {
+		if (record.name.empty() || record.uuid.empty() ||
+		    sourcesByUUID.find(std::string(record.uuid)) != sourcesByUUID.end())
+			return nullptr;
+		auto item = std::make_unique<SourceItem>(static_cast<SourceClass>(record.classByte), record.name,
+							 record.uuid, record.typeId);
+		item->SetVerticalCanvas(item->IsScene() && record.vertical);
+		return item;
+	};
+
+	// Sources and scenes first; filters need their parent's item
+	for (size_t i = 0; i < snapshot.Count(); i++) {
+		SnapshotReader::Record record = snapshot.Get(i);
+		if (record.classByte >= SourceIndex::ClassFilter)
 			continue;
 
-		obs_source_t *source = item->GetSource();
-		if (!source)
+		auto item = restore(record);
+		if (!item)
 			continue;
 
-		obs_scene_t *scene = obs_scene_from_source(source);
-		if (!scene) {
-			obs_source_release(source);
+		SourceItem *added = StoreItem(std::move(item));
+		if (added->IsScene() || added->IsGroup())
+			InternName(added);
+		byRecord[i] = added;
+	}
+
+	for (size_t i = 0; i < snapshot.Count(); i++) {
+		SnapshotReader::Record record = snapshot.Get(i);
+		if (record.classByte != SourceIndex::ClassFilter || record.parentSource == SnapshotReader::kNoParent)
+			continue;
+
+		SourceItem *parent = byRecord[record.parentSource];
+		if (!parent || parent->IsFilter())
 			continue;
+
+		auto item = restore(record);
+		if (item)
+			byRecord[i] = StoreFilter(std::move(item), parent);
+	}
+
+	// Recorded scene membership
+	for (size_t i = 0; i < snapshot.Count(); i++) {
+		SourceItem *item = byRecord[i];
+		if (!item || item->IsFilter())
+			continue;
+
+		SnapshotReader::Record record = snapshot.Get(i);
+		for (uint32_t p = 0; p < record.parentSceneCount; p++) {
+			SourceItem *scene = byRecord[record.parentScenes[p]];
+			if (scene && (scene->IsScene() || scene->IsGroup()))
+				AddParentScene(item, InternName(scene));
 		}
+	}
 
-		std::string sceneName = item->GetName();
-
-		// Enumerate scene items
-		struct EnumContext {
-			SourceCollection *self;
-			std::string sceneName;
-		};
-		EnumContext ctx = {this, sceneName};
-
-		obs_scene_enum_items(scene,
-			[](obs_scene_t *, obs_sceneitem_t *sceneItem, void *param) {
-				EnumContext *ctx = static_cast<EnumContext *>(param);
-
-				obs_source_t *itemSource = obs_sceneitem_get_source(sceneItem);
-				if (!itemSource)
-					return true;
-
-				// Link source to parent scene
-				const char *uuid = obs_source_get_uuid(itemSource);
-				if (uuid) {
-					auto it = ctx->self->sourcesByUUID.find(uuid);
-					if (it != ctx->self->sourcesByUUID.end()) {
-						it->second->AddParentScene(ctx->sceneName);
-					}
-				}
+	sceneGraph.Update();
+	index.SortRows();
 
-				return true;
-			},
-			&ctx);
+	blog(LOG_INFO, "[Source Search] Restored %zu of %zu sources from snapshot in %.1f ms", sources.size(),
+	     snapshot.Count(), (LatencyNow() - start) / 1e6);
+	return !sources.empty();
+}
 
-		obs_source_release(source);
+std::unordered_set<std::string> SourceCollection::CaptureMainScenes()
+{
+	std::unordered_set<std::string> uuids;
+
+	struct obs_frontend_source_list mainScenes = {};
+	obs_frontend_get_scenes(&mainScenes);
+
+	for (size_t i = 0; i < mainScenes.sources.num; i++) {
+		const char *uuid = obs_source_get_uuid(mainScenes.sources.array[i]);
+		if (uuid)
+			uuids.insert(uuid);
+	}
+
+	obs_frontend_source_list_free(&mainScenes);
+	return uuids;
+}
+
+bool SourceCollection::UpdateCanvasMembership()
+{
+	mainSceneUUIDs = CaptureMainScenes();
+
+	bool changed = false;
+	for (auto &item : sources) {
+		if (!item->IsScene())
+			continue;
+
+		bool vertical = mainSceneUUIDs.count(item->GetUUID()) == 0;
+		if (vertical != item->IsVerticalCanvas()) {
+			item->SetVerticalCanvas(vertical);
+			changed = true;
+		}
 	}
+
+	return changed;
+}
+
+void SourceCollection::AddParentScene(SourceItem *item, uint32_t sceneId)
+{
+	item->AddParentScene(sceneId);
+	SyncParents(item);
+}
+
+void SourceCollection::SyncParents(SourceItem *item)
+{
+	index.SetFlag(item->GetIndexRow(), SourceIndex::FlagHasParentScene, !item->GetParentScenes().empty());
+	membershipVersion++;
+
+	// Nesting edges; closures are recomputed lazily from memory, without
+	// enumerating any scene again
+	if (item->IsScene() || item->IsGroup())
+		sceneGraph.SetContainers(InternName(item), item->GetParentScenes());
+}
+
+uint8_t SourceCollection::ReadLiveState(obs_source_t *source)
+{
+	uint8_t state = 0;
+	if (obs_source_active(source))
+		state |= SourceIndex::StateActive;
+	if (obs_source_showing(source))
+		state |= SourceIndex::StateShowing;
+	if ((obs_source_get_output_flags(source) & OBS_SOURCE_AUDIO) && obs_source_muted(source))
+		state |= SourceIndex::StateMuted;
+	if (obs_source_get_type(source) == OBS_SOURCE_TYPE_FILTER && !obs_source_enabled(source))
+		state |= SourceIndex::StateDisabled;
+	return state;
+}
+
+SourceItem *SourceCollection::UpdateLiveState(obs_source_t *source)
+{
+	const char *uuid = obs_source_get_uuid(source);
+	if (!uuid)
+		return nullptr;
+
+	auto it = sourcesByUUID.find(uuid);
+	if (it == sourcesByUUID.end())
+		return nullptr;
+
+	SourceItem *item = it->second;
+	uint8_t state = ReadLiveState(source);
+	if (state == index.LiveState(item->GetIndexRow()))
+		return nullptr;
+
+	index.SetLiveState(item->GetIndexRow(), state);
+	return item;
+}
+
+const std::vector<SourceItem *> &SourceCollection::GetFilters(const SourceItem *source) const
+{
+	static const std::vector<SourceItem *> none;
+	uint32_t id = source->GetNameId();
+	return id < filtersByParent.size() ? filtersByParent[id] : none;
+}
+
+void SourceCollection::CollectNestedScenes(const SourceItem *item, std::vector<uint32_t> &out) const
+{
+	sceneGraph.CollectNested(item->GetParentScenes(), out);
+}
+
+uint32_t SourceCollection::InternName(SourceItem *item)
+{
+	if (item->GetNameId() == SourceItem::kNoNameId) {
+		item->SetNameId(static_cast<uint32_t>(internedNames.size()));
+		internedNames.push_back(StoreInternedName(item->GetName()));
+	}
+	return item->GetNameId();
+}
+
+std::string_view SourceCollection::StoreInternedName(const std::string &name)
+{
+	storedNameBytes += name.size();
+	return nameArena.Store(name);
+}
+
+void SourceCollection::CompactInternedNames()
+{
+	// Views into the old arena are repointed before it is freed
+	StringArena compacted;
+	size_t liveBytes = 0;
+	for (std::string_view &name : internedNames) {
+		name = compacted.Store(name);
+		liveBytes += name.size();
+	}
+
+	nameArena = std::move(compacted);
+	storedNameBytes = liveBytes;
+	deadNameBytes = 0;
+}
+
+void SourceCollection::ReleaseRemoved()
+{
+	removedSources.clear();
+}
+
+SourceItem *SourceCollection::FindByUUID(const std::string &uuid) const
+{
+	auto it = sourcesByUUID.find(uuid);
+	return it != sourcesByUUID.end() ? it->second : nullptr;
 }
 
 std::vector<SourceItem *> SourceCollection::Search(const std::string &searchText,
-						    const std::string &typeFilter) const
+						    const std::string &typeFilter,
+						    SearchScope scope, SearchMode mode,
+						    const CancelToken &cancel) const
 {
+	// Parsed once per query; name terms become a row bitset for the scan
+	SearchQuery query = ParseSearchQuery(searchText);
+	query.matchSettings = settingsIndexed;
+	const std::vector<uint64_t> *nameRows = query.HasNameTerms() ? &NameTermRows(query) : nullptr;
+
+	std::vector<SourceIndex::Row> rows;
+	if (!lastSearch.Run(index, query, typeFilter, scope, mode, rows, nameRows, cancel))
+		return {};
+
+	// Destroyed sources are tombstoned in the index, so no per-item
+	// weak reference upgrade is needed here. Rows arrive in display order.
 	std::vector<SourceItem *> results;
+	results.reserve(rows.size());
+	for (SourceIndex::Row row : rows) {
+		results.push_back(sources[row].get());
+	}
+
+	return results;
+}
+
+// Append string values below data, one per line, up to the text limit
+static void AppendSettingStrings(obs_data_t *data, std::string &out, int depth)
+{
+	for (obs_data_item_t *item = obs_data_first(data); item; obs_data_item_next(&item)) {
+		if (out.size() >= SourceCollection::kSettingsTextLimit) {
+			obs_data_item_release(&item);
+			break;
+		}
+
+		switch (obs_data_item_gettype(item)) {
+		case OBS_DATA_STRING: {
+			const char *value = obs_data_item_get_string(item);
+			if (value && *value) {
+				out.append(value, strnlen(value, SourceCollection::kSettingsTextLimit));
+				out += '\n';
+			}
+			break;
+		}
+
+		case OBS_DATA_OBJECT:
+			if (depth > 0) {
+				obs_data_t *child = obs_data_item_get_obj(item);
+				if (child) {
+					AppendSettingStrings(child, out, depth - 1);
+					obs_data_release(child);
+				}
+			}
+			break;
+
+		case OBS_DATA_ARRAY:
+			// Playlists and file lists
+			if (depth > 0) {
+				obs_data_array_t *array = obs_data_item_get_array(item);
+				size_t count = array ? obs_data_array_count(array) : 0;
+				for (size_t i = 0; i < count && out.size() < SourceCollection::kSettingsTextLimit; i++) {
+					obs_data_t *child = obs_data_array_item(array, i);
+					AppendSettingStrings(child, out, depth - 1);
+					obs_data_release(child);
+				}
+				obs_data_array_release(array);
+			}
+			break;
 
+		default:
+			break;
+		}
+	}
+}
+
+std::string SourceCollection::ExtractSettingsText(obs_source_t *source)
+{
+	std::string text;
+	obs_data_t *settings = obs_source_get_settings(source);
+	if (!settings)
+		return text;
+
+	AppendSettingStrings(settings, text, 2);
+	obs_data_release(settings);
+
+	if (text.size() > kSettingsTextLimit)
+		text.resize(kSettingsTextLimit);
+	return text;
+}
+
+std::vector<SourceCollection::SettingsTarget> SourceCollection::GetSettingsTargets() const
+{
+	std::vector<SettingsTarget> targets;
+	targets.reserve(sources.size());
 	for (const auto &item : sources) {
-		if (!item->IsValid())
+		obs_source_t *source = item->GetSource();
+		if (!source)
 			continue;
+		targets.push_back({item->GetUUID(), obs_source_get_weak_source(source)});
+		obs_source_release(source);
+	}
+	return targets;
+}
 
-		if (!item->MatchesType(typeFilter))
-			continue;
+bool SourceCollection::SetSettingsText(SourceItem *item, const std::string &text)
+{
+	SourceIndex::Row row = item->GetIndexRow();
+	size_t bytes = index.SettingsBytes() - index.SettingsLength(row) + text.size();
+	if (bytes > kSettingsMemoryLimit) {
+		settingsOverLimit++;
+		return false;
+	}
+
+	uint64_t before = index.Generation();
+	index.SetSettingsText(row, text);
+	return index.Generation() != before;
+}
 
-		if (!item->MatchesSearch(searchText))
+void SourceCollection::ApplySettingsTexts(const std::vector<SettingsText> &texts, uint64_t extractNs)
+{
+	settingsIndexed = true;
+	settingsOverLimit = 0;
+
+	size_t indexed = 0;
+	for (const auto &entry : texts) {
+		auto it = sourcesByUUID.find(entry.uuid);
+		if (it == sourcesByUUID.end() || entry.text.empty())
 			continue;
+		if (SetSettingsText(it->second, entry.text))
+			indexed++;
+	}
 
-		results.push_back(item.get());
+	blog(LOG_INFO,
+	     "[Source Search] Settings indexed: %zu of %zu sources, %zu KB, %zu over the %zu MB cap, %.1f ms",
+	     indexed, sources.size(), index.SettingsBytes() / 1024, settingsOverLimit,
+	     kSettingsMemoryLimit / (1024 * 1024), static_cast<double>(extractNs) / 1e6);
+}
+
+bool SourceCollection::UpdateSettingsText(obs_source_t *source)
+{
+	if (!settingsIndexed || !source)
+		return false;
+
+	const char *uuid = obs_source_get_uuid(source);
+	auto it = uuid ? sourcesByUUID.find(uuid) : sourcesByUUID.end();
+	if (it == sourcesByUUID.end())
+		return false;
+
+	return SetSettingsText(it->second, ExtractSettingsText(source));
+}
+
+void SourceCollection::ClearSettingsIndex()
+{
+	settingsIndexed = false;
+	settingsOverLimit = 0;
+	index.ClearSettings();
+}
+
+const std::vector<uint64_t> &SourceCollection::NameTermRows(const SearchQuery &query) const
+{
+	std::string key;
+	for (const auto &scene : query.scenes) {
+		key += "in\x1f" + scene + '\x1e';
+	}
+	for (const auto &parent : query.filterOn) {
+		key += "on\x1f" + parent + '\x1e';
 	}
 
-	// Sort by name
-	std::sort(results.begin(), results.end(),
-		  [](const SourceItem *a, const SourceItem *b) {
-			  return a->GetName() < b->GetName();
-		  });
+	if (key == nameTermsKey && nameTermsGeneration == index.Generation() &&
+	    nameTermsMembership == membershipVersion)
+		return nameTermRows;
 
-	return results;
+	nameTermsKey = std::move(key);
+	nameTermsGeneration = index.Generation();
+	nameTermsMembership = membershipVersion;
+
+	// Interned names cover every scene, group and filter parent
+	std::vector<std::string> foldedNames;
+	foldedNames.reserve(internedNames.size());
+	for (std::string_view name : internedNames) {
+		foldedNames.push_back(FoldSearchText(std::string(name)));
+	}
+
+	auto namesMatching = [&](const std::string &term) {
+		std::string folded = FoldSearchText(term);
+		std::vector<uint32_t> ids;
+		for (uint32_t id = 0; id < foldedNames.size(); id++) {
+			if (foldedNames[id] == folded)
+				ids.push_back(id);
+		}
+		return ids;
+	};
+
+	std::vector<std::vector<uint32_t>> sceneIds;
+	for (const auto &scene : query.scenes) {
+		sceneIds.push_back(namesMatching(scene));
+	}
+
+	// Every in: term needs one scene of that name showing the item
+	auto shownInAll = [&](const SourceItem *item) {
+		for (const auto &ids : sceneIds) {
+			bool shown = false;
+			for (uint32_t sceneId : ids) {
+				if (sceneGraph.IsVisibleIn(item->GetParentScenes(), sceneId)) {
+					shown = true;
+					break;
+				}
+			}
+			if (!shown)
+				return false;
+		}
+		return true;
+	};
+
+	nameTermRows.assign((sources.size() + 63) / 64, 0);
+	auto mark = [this](SourceIndex::Row row) { nameTermRows[row / 64] |= uint64_t(1) << (row % 64); };
+
+	if (query.filterOn.empty()) {
+		for (size_t row = 0; row < sources.size(); row++) {
+			if (shownInAll(sources[row].get()))
+				mark(static_cast<SourceIndex::Row>(row));
+		}
+		return nameTermRows;
+	}
+
+	// Only the filters on the named parents are candidates
+	for (const auto &parent : query.filterOn) {
+		for (uint32_t parentId : namesMatching(parent)) {
+			if (parentId >= filtersByParent.size())
+				continue;
+			for (const SourceItem *filter : filtersByParent[parentId]) {
+				if (shownInAll(filter))
+					mark(filter->GetIndexRow());
+			}
+		}
+	}
+
+	return nameTermRows;
 }
 
 // Utility function
 
-std::string GetTypeDisplayName(const std::string &typeId)
+// Filled by CacheTypeDisplayNames()
+static std::unordered_map<std::string, std::string> typeDisplayNames;
+
+static std::string ResolveTypeDisplayName(const std::string &typeId)
 {
 	// Check our hardcoded map first
 	auto it = SOURCE_TYPE_NAMES.find(typeId);
@@ -494,3 +1229,30 @@ std::string GetTypeDisplayName(const std::string &typeId)
 	// Fallback to type ID
 	return typeId;
 }
+
+std::string GetTypeDisplayName(const std::string &typeId)
+{
+	auto it = typeDisplayNames.find(typeId);
+	if (it != typeDisplayNames.end())
+		return it->second;
+
+	return ResolveTypeDisplayName(typeId);
+}
+
+void CacheTypeDisplayNames()
+{
+	typeDisplayNames.clear();
+
+	const char *typeId = nullptr;
+	for (size_t i = 0; obs_enum_source_types(i, &typeId); i++) {
+		typeDisplayNames.emplace(typeId, ResolveTypeDisplayName(typeId));
+	}
+	for (size_t i = 0; obs_enum_filter_types(i, &typeId); i++) {
+		typeDisplayNames.emplace(typeId, ResolveTypeDisplayName(typeId));
+	}
+	for (const auto &[id, name] : SOURCE_TYPE_NAMES) {
+		typeDisplayNames.emplace(id, name);
+	}
+
+	blog(LOG_INFO, "[Source Search] Cached %zu type names", typeDisplayNames.size());
+}
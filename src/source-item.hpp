@@ -15,9 +15,19 @@
 
 #include <string>
 #include <vector>
-#include <set>
 #include <map>
 #include <memory>
+#include <string_view>
+#include <unordered_set>
+
+#include "index-search.hpp"
+#include "index-snapshot.hpp"
+#include "latency-stats.hpp"
+#include "scene-graph.hpp"
+#include "search-matcher.hpp"
+#include "source-index.hpp"
+#include "string-arena.hpp"
+#include "type-registry.hpp"
 
 // Represents a source's class type
 enum class SourceClass {
@@ -34,6 +44,11 @@ extern const std::map<std::string, std::string> SOURCE_TYPE_NAMES;
 class SourceItem {
 public:
 	explicit SourceItem(obs_source_t *source);
+
+	// An item restored from a snapshot, with no source bound: GetSource()
+	// looks it up by UUID instead
+	SourceItem(SourceClass itemClass, std::string_view itemName, std::string_view itemUuid,
+		   std::string_view itemTypeId);
 	~SourceItem();
 
 	// Prevent copying
@@ -41,43 +56,68 @@ public:
 	SourceItem &operator=(const SourceItem &) = delete;
 
 	// Getters
-	std::string GetName() const;
+	const std::string &GetName() const { return name; }
+	const std::string &GetSearchName() const { return searchName; }  // Folded for matching
 	std::string GetDisplayName() const;  // With (H)/(V) prefix for scenes
-	std::string GetUUID() const;
+	const std::string &GetUUID() const { return uuid; }
 	std::string GetTypeId() const;
 	std::string GetTypeDisplayName() const;
 	SourceClass GetSourceClass() const { return sourceClass; }
 	obs_source_t *GetSource() const;
 
-	// Scene relationships
-	void AddParentScene(const std::string &sceneName);
-	const std::set<std::string> &GetParentScenes() const { return parentScenes; }
+	// Update the cached name (from source_rename)
+	void SetName(const std::string &newName);
+
+	// Interned name ID, assigned once another item refers to this one
+	// (see SourceCollection::GetInternedName)
+	static constexpr uint32_t kNoNameId = UINT32_MAX;
+	uint32_t GetNameId() const { return nameId; }
+	void SetNameId(uint32_t id) { nameId = id; }
 
-	// Filter parent source (for filters)
-	void SetParentSourceName(const std::string &sourceName) { parentSourceName = sourceName; }
-	std::string GetParentSourceName() const { return parentSourceName; }
+	// Scene relationships, as sorted name IDs of the containing scenes
+	void AddParentScene(uint32_t sceneId);
+	void RemoveParentScene(uint32_t sceneId);
+	const std::vector<uint32_t> &GetParentScenes() const { return parentScenes; }
+
+	// Filter parent source (for filters), as its name ID
+	void SetParentSourceId(uint32_t sourceId) { parentSourceId = sourceId; }
+	uint32_t GetParentSourceId() const { return parentSourceId; }
 	bool IsFilter() const { return sourceClass == SourceClass::Filter; }
 
-	// Vertical Canvas detection
-	bool IsVerticalCanvas() const;
+	// Vertical Canvas detection (set by SourceCollection from the main scene list)
+	bool IsVerticalCanvas() const { return verticalCanvas; }
+	void SetVerticalCanvas(bool vertical) { verticalCanvas = vertical; }
 	bool IsScene() const { return sourceClass == SourceClass::Scene; }
 	bool IsGroup() const { return sourceClass == SourceClass::Group; }
 
-	// Search matching
+	// Search matching (searchText must already be folded with FoldSearchText)
 	bool MatchesSearch(const std::string &searchText) const;
 	bool MatchesType(const std::string &typeFilter) const;
 
 	// Validity check
 	bool IsValid() const;
 
+	// Position in the collection (and its search index)
+	SourceIndex::Row GetIndexRow() const { return indexRow; }
+	void SetIndexRow(SourceIndex::Row row) { indexRow = row; }
+
 private:
 	obs_weak_source_t *weakSource;
 	SourceClass sourceClass;
-	std::set<std::string> parentScenes;
-	std::string parentSourceName;  // For filters: the source they're attached to
+	std::vector<uint32_t> parentScenes;
+	uint32_t parentSourceId;  // For filters: the source they're attached to
+	uint32_t nameId;
+
+	// Cached name and UUID so searching never touches libobs
+	std::string name;
+	std::string searchName;
+	std::string uuid;
 
 	// Cached type ID for filtering
 	std::string cachedTypeId;
+
+	SourceIndex::Row indexRow;
+	bool verticalCanvas;
 };
 
 // Collection of all sources for searching
@@ -89,17 +129,122 @@ public:
 	// Rebuild the entire source collection
 	void Refresh();
 
+	// Rebuild from a main scene snapshot taken with CaptureMainScenes();
+	// makes no frontend API calls, so it can run on a worker thread
+	void Refresh(std::unordered_set<std::string> mainScenes);
+
+	// Snapshot the UUIDs of the frontend's main (horizontal) scenes (UI thread)
+	static std::unordered_set<std::string> CaptureMainScenes();
+
+	// Serialize rows and parent links (see SnapshotWriter)
+	std::string SaveSnapshot() const;
+
+	// Re-create the collection from a snapshot's records alone (names,
+	// types, canvas flags and links as recorded), without libobs calls, so
+	// it is cheap enough for the UI thread. Rows may name sources that are
+	// gone; a live Refresh() replaces them. False if nothing was restored.
+	bool LoadSnapshot(const SnapshotReader &snapshot);
+
 	// Clear all sources
 	void Clear();
 
+	// Stage timings of the last Refresh(), in nanoseconds
+	struct RefreshTimings {
+		uint64_t enumerate = 0;
+		uint64_t filters = 0;
+		uint64_t sceneItems = 0;
+		uint64_t total = 0;
+	};
+	const RefreshTimings &GetRefreshTimings() const { return refreshTimings; }
+
 	// Get all sources
 	const std::vector<std::unique_ptr<SourceItem>> &GetSources() const { return sources; }
 
-	// Get discovered source types for filter dropdown
-	const std::map<std::string, std::string> &GetDiscoveredTypes() const { return discoveredTypes; }
+	// Deep search: string setting values (file paths, URLs, text) are
+	// indexed per item when enabled and then matched along with names
+	static constexpr size_t kSettingsTextLimit = 4096;               // Per item
+	static constexpr size_t kSettingsMemoryLimit = 16 * 1024 * 1024;  // Per collection
+
+	struct SettingsTarget {
+		std::string uuid;
+		obs_weak_source_t *weakSource;  // Owned by the receiver
+	};
+	struct SettingsText {
+		std::string uuid;
+		std::string text;
+	};
+
+	// Setting values of a source, newline separated (any thread)
+	static std::string ExtractSettingsText(obs_source_t *source);
+
+	// Every item, to extract off the UI thread
+	std::vector<SettingsTarget> GetSettingsTargets() const;
+
+	// Store extracted text and switch matching on; logs the totals
+	void ApplySettingsTexts(const std::vector<SettingsText> &texts, uint64_t extractNs);
+
+	// Re-extract one source after its "update" signal; false if unchanged
+	// or deep search is off
+	bool UpdateSettingsText(obs_source_t *source);
+
+	void ClearSettingsIndex();
+	bool HasSettingsIndex() const { return settingsIndexed; }
+
+	// Active/showing/muted/disabled bits of a source, read once (any thread)
+	static uint8_t ReadLiveState(obs_source_t *source);
+
+	// Re-read one source after a state signal; the item if its bits changed
+	SourceItem *UpdateLiveState(obs_source_t *source);
+	uint8_t GetLiveState(const SourceItem *item) const { return index.LiveState(item->GetIndexRow()); }
+
+	// Types present in the collection, for the filter dropdown
+	const TypeRegistry &GetTypes() const { return types; }
+
+	// Search and filter. Not reentrant (the query caches are shared), so
+	// run one search at a time; a cancelled search returns partial rows.
+	std::vector<SourceItem *> Search(const std::string &searchText, const std::string &typeFilter,
+					 SearchScope scope, SearchMode mode = SearchMode::Contains,
+					 const CancelToken &cancel = CancelToken()) const;
+
+	// Bumped by every change to rows; results (item pointers included)
+	// from an older generation may be stale
+	uint64_t Generation() const { return index.Generation(); }
 
-	// Search and filter
-	std::vector<SourceItem *> Search(const std::string &searchText, const std::string &typeFilter) const;
+	// Incremental updates from source signals (avoid a full Refresh)
+	bool InsertSource(obs_source_t *source);
+	bool RemoveSource(const std::string &uuid);
+	bool RenameSource(obs_source_t *source);  // Reads the current name
+
+	// Re-check whether a scene or group currently holds a source and update
+	// the source's parents (and the containment graph) to match; handles
+	// both item_add and item_remove. Returns true if anything changed.
+	bool RelinkSceneItem(obs_source_t *scene, obs_source_t *item);
+
+	// Compact rows tombstoned by RemoveSource (before rebuilding results)
+	void PurgeRemoved();
+
+	// Free items purged since the last call (after results stop referencing them)
+	void ReleaseRemoved();
+
+	// Look up an item by source UUID
+	SourceItem *FindByUUID(const std::string &uuid) const;
+
+	// Current name behind an interned name ID (parent scenes, filter parents)
+	std::string_view GetInternedName(uint32_t id) const
+	{
+		return id < internedNames.size() ? internedNames[id] : std::string_view();
+	}
+
+	// Filters on a source, in the order they were linked; O(filters on it)
+	const std::vector<SourceItem *> &GetFilters(const SourceItem *source) const;
+
+	// Scenes that show an item only through nested scenes or groups
+	// (its direct parents are GetParentScenes()), as name IDs
+	void CollectNestedScenes(const SourceItem *item, std::vector<uint32_t> &out) const;
+
+	// Re-read the frontend's main scene list and update the (H)/(V) flag of
+	// every scene; returns true if any flag changed
+	bool UpdateCanvasMembership();
 
 private:
 	// Enumeration callbacks
@@ -107,21 +252,90 @@ private:
 	static bool EnumSceneItemsCallback(obs_scene_t *scene, obs_sceneitem_t *item, void *param);
 
 	// Add a source to collection
-	void AddSource(obs_source_t *source);
+	SourceItem *AddSource(obs_source_t *source);
 
 	// Add a filter to collection with parent info
-	void AddFilter(obs_source_t *filter, const std::string &parentName);
+	SourceItem *AddFilter(obs_source_t *filter, SourceItem *parent);
+
+	// Index a new item (and link a filter to its parent), without libobs calls
+	SourceItem *StoreItem(std::unique_ptr<SourceItem> item);
+	SourceItem *StoreFilter(std::unique_ptr<SourceItem> item, SourceItem *parent);
 
 	// Enumerate and link filters to their parent sources
 	void LinkFilters();
+	void LinkFiltersFor(SourceItem *item);
 
 	// Link scene items to their parent scenes
 	void LinkSceneItems();
+	void LinkSceneItemsFor(SourceItem *sceneItem);
+
+	// Scene or group behind a source (borrowed, nullptr for other sources)
+	static obs_scene_t *SceneFromSource(obs_source_t *source);
+	static bool SceneContains(obs_scene_t *scene, obs_source_t *target);
+
+	// Record scene membership on the item, its index row and, for nested
+	// scenes and groups, the containment graph
+	void AddParentScene(SourceItem *item, uint32_t sceneId);
+	void SyncParents(SourceItem *item);
+
+	// Name ID of an item, interning its name on first use
+	uint32_t InternName(SourceItem *item);
 
 	std::vector<std::unique_ptr<SourceItem>> sources;
+	std::vector<SourceItem *> tombstones;                     // Pending purge
+	std::vector<std::unique_ptr<SourceItem>> removedSources;  // Pending release
 	std::map<std::string, SourceItem *> sourcesByUUID;
-	std::map<std::string, std::string> discoveredTypes;  // typeId -> displayName
+	TypeRegistry types;                              // Item count per type ID
+	std::unordered_set<std::string> mainSceneUUIDs;  // Scenes not on Vertical Canvas
+
+	// Names that other items refer to, stored once per refresh; renames
+	// repoint the entry, so members and filters never hold name copies
+	StringArena nameArena;
+	std::vector<std::string_view> internedNames;
+	size_t storedNameBytes = 0;  // Copied into the arena
+	size_t deadNameBytes = 0;    // Of those, left behind by renames
+
+	// Store a name for an ID, re-storing the live ones once renames have
+	// orphaned half of the arena
+	std::string_view StoreInternedName(const std::string &name);
+	void CompactInternedNames();
+
+	// Filters per parent, indexed by the parent's name ID (built by
+	// AddFilter, pruned as filters are purged)
+	std::vector<std::vector<SourceItem *>> filtersByParent;
+
+	// Scene/group nesting with precomputed closure
+	SceneGraph sceneGraph;
+
+	RefreshTimings refreshTimings;
+
+	// Bumped by every parent scene change
+	uint64_t membershipVersion = 0;
+
+	// Store one item's settings text within kSettingsMemoryLimit
+	bool SetSettingsText(SourceItem *item, const std::string &text);
+	bool settingsIndexed = false;
+	size_t settingsOverLimit = 0;  // Items left out by the memory cap
+
+	// Packed per-row search data (row N mirrors sources[N])
+	SourceIndex index;
+
+	// Query logic (type lookup, folding, narrowing) over the index
+	mutable IndexSearch lastSearch;
+
+	// Rows passing a query's in:/filter-on: terms, kept while the terms
+	// and the index stay the same
+	const std::vector<uint64_t> &NameTermRows(const SearchQuery &query) const;
+	mutable std::string nameTermsKey;
+	mutable uint64_t nameTermsGeneration = 0;
+	mutable uint64_t nameTermsMembership = 0;
+	mutable std::vector<uint64_t> nameTermRows;
 };
 
 // Utility function to get friendly type name
 std::string GetTypeDisplayName(const std::string &typeId);
+
+// Resolve the display names of all registered source and filter types
+// once (module post-load, before any collection is built); lookups are
+// read-only afterwards and fall back to OBS for types added later
+void CacheTypeDisplayNames();
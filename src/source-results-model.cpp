@@ -0,0 +1,356 @@
+/*
+ * OBS Source Search Plugin
+ * Copyright (C) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ */
+
+#include "source-results-model.hpp"
+
+#include <obs-module.h>
+
+#include <QStringList>
+
+#include <algorithm>
+#include <unordered_map>
+
+SourceResultsModel::SourceResultsModel(QObject *parent) : QAbstractListModel(parent) {}
+
+void SourceResultsModel::SetResults(std::shared_ptr<const SourceCollection> owner,
+				    std::vector<SourceItem *> newResults)
+{
+	// Rows of another collection (or other collections) can't be diffed
+	if (owner && owner == collection && otherResults.empty() && ApplyDiff(newResults)) {
+		RefreshCachedText();
+		return;
+	}
+
+	beginResetModel();
+	collection = std::move(owner);
+	results = std::move(newResults);
+	rowText.assign(results.size(), QString());
+	otherCollections.clear();
+	otherResults.clear();
+	endResetModel();
+}
+
+bool SourceResultsModel::ApplyDiff(std::vector<SourceItem *> &newResults)
+{
+	std::unordered_map<const SourceItem *, uint32_t> newPosition;
+	newPosition.reserve(newResults.size());
+	for (uint32_t i = 0; i < newResults.size(); i++) {
+		newPosition.emplace(newResults[i], i);
+	}
+
+	// Old rows to keep: the longest run of them that is still in order in
+	// the new list (one pass with binary search, O(n log n)). Contains
+	// results keep name order, so this is everything still matching
+	// except a renamed row that moved.
+	std::vector<int64_t> target(results.size(), -1);
+	for (size_t i = 0; i < results.size(); i++) {
+		auto it = newPosition.find(results[i]);
+		if (it != newPosition.end())
+			target[i] = it->second;
+	}
+
+	std::vector<size_t> tails;  // tails[k]: old row ending the best run of length k + 1
+	std::vector<int64_t> previous(results.size(), -1);
+	for (size_t i = 0; i < results.size(); i++) {
+		if (target[i] < 0)
+			continue;
+
+		auto pos = std::lower_bound(tails.begin(), tails.end(), target[i],
+					    [&target](size_t row, int64_t value) { return target[row] < value; });
+		if (pos != tails.begin())
+			previous[i] = static_cast<int64_t>(*(pos - 1));
+		if (pos == tails.end())
+			tails.push_back(i);
+		else
+			*pos = i;
+	}
+
+	std::vector<bool> keepOld(results.size(), false);
+	std::vector<bool> keptNew(newResults.size(), false);
+	for (int64_t i = tails.empty() ? -1 : static_cast<int64_t>(tails.back()); i >= 0; i = previous[i]) {
+		keepOld[i] = true;
+		keptNew[target[i]] = true;
+	}
+
+	// Larger than the list itself, or too scattered: reset instead
+	size_t kept = tails.size();
+	size_t edits = (results.size() - kept) + (newResults.size() - kept);
+	if (edits > std::max(results.size(), newResults.size()))
+		return false;
+
+	size_t batches = 0;
+	for (size_t i = 0; i < keepOld.size(); i++) {
+		batches += !keepOld[i] && (i == 0 || keepOld[i - 1]);
+	}
+	for (size_t i = 0; i < keptNew.size(); i++) {
+		batches += !keptNew[i] && (i == 0 || keptNew[i - 1]);
+	}
+	if (batches > kMaxDiffBatches)
+		return false;
+
+	// Removals from the back, so earlier row numbers stay valid
+	for (size_t end = results.size(); end > 0;) {
+		if (keepOld[end - 1]) {
+			end--;
+			continue;
+		}
+
+		size_t first = end - 1;
+		while (first > 0 && !keepOld[first - 1])
+			first--;
+
+		beginRemoveRows(QModelIndex(), static_cast<int>(first), static_cast<int>(end - 1));
+		results.erase(results.begin() + static_cast<std::ptrdiff_t>(first),
+			      results.begin() + static_cast<std::ptrdiff_t>(end));
+		rowText.erase(rowText.begin() + static_cast<std::ptrdiff_t>(first),
+			      rowText.begin() + static_cast<std::ptrdiff_t>(end));
+		endRemoveRows();
+		end = first;
+	}
+
+	// The kept rows are in new-list order now; insert the rest around them
+	for (size_t first = 0; first < newResults.size();) {
+		if (keptNew[first]) {
+			first++;
+			continue;
+		}
+
+		size_t end = first + 1;
+		while (end < newResults.size() && !keptNew[end])
+			end++;
+
+		beginInsertRows(QModelIndex(), static_cast<int>(first), static_cast<int>(end - 1));
+		results.insert(results.begin() + static_cast<std::ptrdiff_t>(first),
+			       newResults.begin() + static_cast<std::ptrdiff_t>(first),
+			       newResults.begin() + static_cast<std::ptrdiff_t>(end));
+		rowText.insert(rowText.begin() + static_cast<std::ptrdiff_t>(first), end - first, QString());
+		endInsertRows();
+		first = end;
+	}
+
+	return true;
+}
+
+void SourceResultsModel::RepaintItems(const std::unordered_set<const SourceItem *> &items)
+{
+	if (!items.empty() && collection)
+		RefreshCachedText(&items);
+}
+
+void SourceResultsModel::RefreshCachedText(const std::unordered_set<const SourceItem *> *only)
+{
+	auto candidate = [&](size_t row) {
+		return !rowText[row].isNull() && (!only || only->count(results[row]));
+	};
+
+	// Only rows the view has shown have text to compare; the rest are
+	// built fresh when they scroll into view
+	for (size_t first = 0; first < results.size();) {
+		if (!candidate(first)) {
+			first++;
+			continue;
+		}
+
+		QString text = FormatItem(results[first]);
+		if (text == rowText[first]) {
+			first++;
+			continue;
+		}
+
+		size_t end = first + 1;
+		rowText[first] = std::move(text);
+		while (end < results.size() && candidate(end)) {
+			QString next = FormatItem(results[end]);
+			if (next == rowText[end])
+				break;
+			rowText[end++] = std::move(next);
+		}
+
+		emit dataChanged(index(static_cast<int>(first)), index(static_cast<int>(end - 1)), {Qt::DisplayRole});
+		first = end;
+	}
+}
+
+void SourceResultsModel::SetOtherResults(std::vector<CollectionCache::Entry> owners, std::vector<OtherRow> rows)
+{
+	beginResetModel();
+	collection.reset();
+	results.clear();
+	rowText.clear();
+	otherCollections = std::move(owners);
+	otherResults = std::move(rows);
+	endResetModel();
+}
+
+void SourceResultsModel::Clear()
+{
+	SetResults(nullptr, {});
+}
+
+void SourceResultsModel::SetThumbnails(ThumbnailCache *cache)
+{
+	if (cache == thumbnails)
+		return;
+
+	// Row heights change with the decoration
+	beginResetModel();
+	thumbnails = cache;
+	endResetModel();
+}
+
+void SourceResultsModel::RepaintThumbnails(const std::unordered_set<std::string> &uuids)
+{
+	if (!thumbnails || uuids.empty())
+		return;
+
+	for (size_t first = 0; first < results.size();) {
+		if (!uuids.count(results[first]->GetUUID())) {
+			first++;
+			continue;
+		}
+
+		size_t end = first + 1;
+		while (end < results.size() && uuids.count(results[end]->GetUUID()))
+			end++;
+
+		emit dataChanged(index(static_cast<int>(first)), index(static_cast<int>(end - 1)), {Qt::DecorationRole});
+		first = end;
+	}
+}
+
+SourceItem *SourceResultsModel::ItemAt(const QModelIndex &index) const
+{
+	if (!index.isValid() || index.row() < 0 || static_cast<size_t>(index.row()) >= results.size())
+		return nullptr;
+
+	return results[static_cast<size_t>(index.row())];
+}
+
+int SourceResultsModel::rowCount(const QModelIndex &parent) const
+{
+	if (parent.isValid())
+		return 0;
+
+	return static_cast<int>(results.size() + otherResults.size());
+}
+
+QVariant SourceResultsModel::data(const QModelIndex &index, int role) const
+{
+	if (role == Qt::DecorationRole && thumbnails && otherResults.empty()) {
+		// Every row gets a pixmap of the same size so heights stay uniform
+		SourceItem *item = ItemAt(index);
+		if (!item)
+			return QVariant();
+		const QPixmap *pixmap = item->IsFilter() ? nullptr : thumbnails->Find(item->GetUUID());
+		return pixmap ? *pixmap : thumbnails->Placeholder();
+	}
+
+	if (role != Qt::DisplayRole)
+		return QVariant();
+
+	if (!otherResults.empty()) {
+		if (!index.isValid() || index.row() < 0 || static_cast<size_t>(index.row()) >= otherResults.size())
+			return QVariant();
+		return FormatOther(otherResults[static_cast<size_t>(index.row())]);
+	}
+
+	SourceItem *item = ItemAt(index);
+	if (!item)
+		return QVariant();
+
+	QString &text = rowText[static_cast<size_t>(index.row())];
+	if (text.isNull())
+		text = FormatItem(item);
+	return text;
+}
+
+QString SourceResultsModel::FormatItem(const SourceItem *item) const
+{
+	// Create display text
+	QString displayText = QString::fromStdString(item->GetDisplayName());
+
+	// Add type info
+	displayText += QString(" [%1]").arg(QString::fromStdString(item->GetTypeDisplayName()));
+
+	// Live state, kept current by source signals
+	uint8_t state = collection->GetLiveState(item);
+	QStringList states;
+	if (state & SourceIndex::StateActive)
+		states.append(obs_module_text("StateLive"));
+	else if (state & SourceIndex::StateShowing)
+		states.append(obs_module_text("StateShowing"));
+	if (state & SourceIndex::StateMuted)
+		states.append(obs_module_text("StateMuted"));
+	if (state & SourceIndex::StateDisabled)
+		states.append(obs_module_text("StateDisabled"));
+	if (!states.isEmpty())
+		displayText += QString(" (%1)").arg(states.join(", "));
+
+	// For filters, show what source they're on
+	if (item->IsFilter()) {
+		std::string_view parentSource = collection->GetInternedName(item->GetParentSourceId());
+		if (!parentSource.empty()) {
+			displayText += QString(" on: %1")
+					       .arg(QString::fromUtf8(parentSource.data(),
+								      static_cast<qsizetype>(parentSource.size())));
+		}
+	} else {
+		// Add parent scenes for regular sources
+		const auto &parents = item->GetParentScenes();
+		if (!parents.empty()) {
+			displayText += QString(" in: %1").arg(SceneNames(parents).join(", "));
+
+			// Outer scenes that show it through a nested scene or group
+			std::vector<uint32_t> nested;
+			collection->CollectNestedScenes(item, nested);
+			if (!nested.empty())
+				displayText += QString("; nested in: %1").arg(SceneNames(nested).join(", "));
+		}
+	}
+
+	return displayText;
+}
+
+QStringList SourceResultsModel::SceneNames(const std::vector<uint32_t> &sceneIds) const
+{
+	QStringList names;
+	for (uint32_t sceneId : sceneIds) {
+		std::string_view name = collection->GetInternedName(sceneId);
+		names.append(QString::fromUtf8(name.data(), static_cast<qsizetype>(name.size())));
+	}
+	// IDs follow scene enumeration order; list names sorted
+	names.sort();
+	return names;
+}
+
+QString SourceResultsModel::FormatOther(const OtherRow &row) const
+{
+	const CollectionFile &file = row.collection->file;
+	const CollectionEntry &entry = file.entries[row.entry];
+
+	// Collection first: that's what these rows answer
+	QString displayText = QString("%1: %2 [%3]")
+				      .arg(QString::fromStdString(file.name))
+				      .arg(QString::fromStdString(entry.name))
+				      .arg(QString::fromStdString(GetTypeDisplayName(entry.typeId)));
+
+	if (entry.parentSource != CollectionEntry::kNoParent) {
+		displayText += QString(" on: %1").arg(QString::fromStdString(file.entries[entry.parentSource].name));
+	} else if (!entry.parentScenes.empty()) {
+		QStringList names;
+		for (uint32_t scene : entry.parentScenes) {
+			names.append(QString::fromStdString(file.entries[scene].name));
+		}
+		names.sort();
+		displayText += QString(" in: %1").arg(names.join(", "));
+	}
+
+	return displayText;
+}
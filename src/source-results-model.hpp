@@ -0,0 +1,87 @@
+/*
+ * OBS Source Search Plugin
+ * Copyright (C) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ */
+
+#pragma once
+
+#include <QAbstractListModel>
+#include <QStringList>
+
+#include <memory>
+#include <unordered_set>
+#include <vector>
+
+#include "collection-cache.hpp"
+#include "source-item.hpp"
+#include "thumbnail-cache.hpp"
+
+// List model over the current search results. Only the result vector is
+// kept; row text is built in data() when the view asks for a visible row.
+// New results from the same collection are applied as row removals and
+// insertions, so scroll position and selection survive a keystroke.
+class SourceResultsModel : public QAbstractListModel {
+	Q_OBJECT
+
+public:
+	explicit SourceResultsModel(QObject *parent = nullptr);
+
+	// Replace the results (items must stay alive until the next call or
+	// Clear); the collection resolves the interned parent names. Kept
+	// rows whose text changed (renames, scene membership) are repainted.
+	void SetResults(std::shared_ptr<const SourceCollection> owner, std::vector<SourceItem *> newResults);
+	void Clear();
+
+	// Rows from inactive scene collections instead (no live source, so
+	// ItemAt returns nullptr for them)
+	struct OtherRow {
+		const IndexedCollection *collection;
+		uint32_t entry;
+	};
+	void SetOtherResults(std::vector<CollectionCache::Entry> owners, std::vector<OtherRow> rows);
+
+	// Repaint the shown rows of these items (live state changed)
+	void RepaintItems(const std::unordered_set<const SourceItem *> &items);
+
+	// Previews as the rows' decoration (nullptr: none)
+	void SetThumbnails(ThumbnailCache *cache);
+
+	// Repaint the decoration of rows showing these sources
+	void RepaintThumbnails(const std::unordered_set<std::string> &uuids);
+
+	// Item behind a view index (nullptr if out of range)
+	SourceItem *ItemAt(const QModelIndex &index) const;
+
+	int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+	QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+private:
+	// Above this many remove/insert batches a reset is cheaper for the view
+	static constexpr size_t kMaxDiffBatches = 64;
+
+	// Edit the current rows into newResults; false if a reset is better
+	bool ApplyDiff(std::vector<SourceItem *> &newResults);
+
+	// Repaint kept rows whose cached text no longer matches (all of them,
+	// or only those of the given items)
+	void RefreshCachedText(const std::unordered_set<const SourceItem *> *only = nullptr);
+
+	// Row text: name, type, live state and parent scenes (or the filter's source)
+	QString FormatItem(const SourceItem *item) const;
+	QStringList SceneNames(const std::vector<uint32_t> &sceneIds) const;
+	QString FormatOther(const OtherRow &row) const;
+
+	std::shared_ptr<const SourceCollection> collection;
+	std::vector<SourceItem *> results;
+	mutable std::vector<QString> rowText;  // Per result row, null until shown
+
+	ThumbnailCache *thumbnails = nullptr;
+
+	std::vector<CollectionCache::Entry> otherCollections;
+	std::vector<OtherRow> otherResults;
+};
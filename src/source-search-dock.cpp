@@ -19,41 +19,126 @@
 #include <QAction>
 #include <QApplication>
 #include <QShowEvent>
+#include <QHideEvent>
+#include <QScrollBar>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <unordered_set>
 
 SourceSearchDock::SourceSearchDock(QWidget *parent)
 	: QFrame(parent),
 	  mainLayout(nullptr),
 	  searchBox(nullptr),
 	  searchScope(nullptr),
+	  searchMode(nullptr),
 	  typeFilter(nullptr),
-	  resultsList(nullptr),
+	  deepSearch(nullptr),
+	  showThumbnails(nullptr),
+	  resultsView(nullptr),
+	  resultsModel(nullptr),
 	  statusLabel(nullptr),
+	  statsLabel(nullptr),
+	  showStatsAction(nullptr),
 	  sourceCollection(nullptr),
+	  typesShownVersion(0),
 	  searchTimer(nullptr),
+	  lastKeystroke(0),
+	  searchPool(nullptr),
+	  searchTicket(0),
+	  remoteTicket(0),
+	  searchInFlight(false),
 	  refreshTimer(nullptr),
+	  repaintTimer(nullptr),
+	  thumbnails(nullptr),
+	  thumbnailTimer(nullptr),
+	  statsTimer(nullptr),
+	  statsLogged(0),
+	  fullRefreshPending(false),
+	  refreshPool(nullptr),
+	  refreshGeneration(0),
+	  refreshInFlight(false),
+	  changeRing(kChangeRingCapacity),
+	  drainScheduled(false),
+	  ringOverflowed(false),
 	  signalsConnected(false),
-	  initialized(false)
+	  initialized(false),
+	  deepSearchEnabled(false),
+	  collectionScanInFlight(false),
+	  collectionScanQueued(false)
 {
 	SetupUI();
 
-	sourceCollection = std::make_unique<SourceCollection>();
+	sourceCollection = std::make_shared<SourceCollection>();
+
+	// One builder at a time; a superseded build finishes and is dropped
+	refreshPool = new QThreadPool(this);
+	refreshPool->setMaxThreadCount(1);
+
+	// Searches get their own worker so a rebuild never delays one
+	searchPool = new QThreadPool(this);
+	searchPool->setMaxThreadCount(1);
+
+	// Very large scans (deep search, big collections) are split over a
+	// few more threads
+	scanPool = std::make_unique<ScanPool>();
+	SourceIndex::SetScanExecutor(scanPool.get());
 
 	// Setup search debounce timer
 	searchTimer = new QTimer(this);
 	searchTimer->setSingleShot(true);
-	searchTimer->setInterval(150);  // 150ms debounce
+	searchTimer->setInterval(kMaxDebounceMs);
 	connect(searchTimer, &QTimer::timeout, this, &SourceSearchDock::PerformSearch);
 
 	// Setup refresh debounce timer (avoid refresh spam during OBS startup)
+	// Source signals patch the collection directly; this only redraws
 	refreshTimer = new QTimer(this);
 	refreshTimer->setSingleShot(true);
 	refreshTimer->setInterval(500);  // 500ms debounce - coalesce rapid source changes
 	connect(refreshTimer, &QTimer::timeout, this, &SourceSearchDock::OnSourcesChanged);
+
+	// State signals come in bursts (a scene switch flips every item in it)
+	repaintTimer = new QTimer(this);
+	repaintTimer->setSingleShot(true);
+	repaintTimer->setInterval(kFrameMs);
+	connect(repaintTimer, &QTimer::timeout, this, &SourceSearchDock::RepaintChangedRows);
+
+	// Previews are drawn on the render thread within a per-frame budget;
+	// finished ones are repainted with the state rows
+	thumbnails = new ThumbnailCache(this);
+	connect(thumbnails, &ThumbnailCache::ThumbnailReady, this, [this](const std::string &uuid) {
+		repaintThumbnails.insert(uuid);
+		if (!repaintTimer->isActive())
+			repaintTimer->start();
+	});
+
+	thumbnailTimer = new QTimer(this);
+	thumbnailTimer->setInterval(250);
+	connect(thumbnailTimer, &QTimer::timeout, this, &SourceSearchDock::RequestVisibleThumbnails);
+	connect(resultsView->verticalScrollBar(), &QScrollBar::valueChanged, this,
+		&SourceSearchDock::RequestVisibleThumbnails);
+
+	// Periodic timing summary in the OBS log (skipped while idle)
+	statsTimer = new QTimer(this);
+	statsTimer->setInterval(60000);
+	connect(statsTimer, &QTimer::timeout, this, &SourceSearchDock::LogStats);
+	statsTimer->start();
 }
 
 SourceSearchDock::~SourceSearchDock()
 {
 	Cleanup();
+
+	// Don't let a background build or search outlive the dock
+	refreshPool->waitForDone();
+	searchPool->waitForDone();
+	SourceIndex::SetScanExecutor(nullptr);
 }
 
 void SourceSearchDock::SetupUI()
@@ -68,6 +153,7 @@ void SourceSearchDock::SetupUI()
 
 	searchBox = new QLineEdit(this);
 	searchBox->setPlaceholderText(obs_module_text("SearchPlaceholder"));
+	searchBox->setToolTip(obs_module_text("SearchSyntax"));
 	searchBox->setClearButtonEnabled(true);
 	connect(searchBox, &QLineEdit::textChanged, this, &SourceSearchDock::OnSearchTextChanged);
 	searchRow->addWidget(searchBox);
@@ -85,12 +171,23 @@ void SourceSearchDock::SetupUI()
 	searchScope->addItem(obs_module_text("Sources"), "sources");
 	searchScope->addItem(obs_module_text("Filters"), "filters");
 	searchScope->addItem(obs_module_text("All"), "all");
+	searchScope->addItem(obs_module_text("OtherCollections"), "collections");
 	searchScope->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Fixed);
 	connect(searchScope, QOverload<int>::of(&QComboBox::currentIndexChanged),
 		this, &SourceSearchDock::OnSearchScopeChanged);
 	scopeRow->addWidget(searchScope);
 	currentSearchScope = "sources";
 
+	// Match mode: plain substring, or fuzzy abbreviations ranked by score
+	searchMode = new QComboBox(this);
+	searchMode->addItem(obs_module_text("MatchContains"), "contains");
+	searchMode->addItem(obs_module_text("MatchFuzzy"), "fuzzy");
+	searchMode->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Fixed);
+	connect(searchMode, QOverload<int>::of(&QComboBox::currentIndexChanged),
+		this, &SourceSearchDock::OnSearchModeChanged);
+	scopeRow->addWidget(searchMode);
+	currentSearchMode = "contains";
+
 	mainLayout->addLayout(scopeRow);
 
 	// Type filter row
@@ -106,21 +203,51 @@ void SourceSearchDock::SetupUI()
 		this, &SourceSearchDock::OnTypeFilterChanged);
 	filterRow->addWidget(typeFilter);
 
+	// Deep search: also match setting values (indexed in the background)
+	deepSearch = new QCheckBox(obs_module_text("DeepSearch"), this);
+	deepSearch->setToolTip(obs_module_text("DeepSearchTip"));
+	connect(deepSearch, &QCheckBox::toggled, this, &SourceSearchDock::OnDeepSearchToggled);
+	filterRow->addWidget(deepSearch);
+
+	// Optional previews next to results
+	showThumbnails = new QCheckBox(obs_module_text("Thumbnails"), this);
+	showThumbnails->setToolTip(obs_module_text("ThumbnailsTip"));
+	connect(showThumbnails, &QCheckBox::toggled, this, &SourceSearchDock::OnThumbnailsToggled);
+	filterRow->addWidget(showThumbnails);
+
 	mainLayout->addLayout(filterRow);
 
-	// Results list
-	resultsList = new QListWidget(this);
-	resultsList->setSelectionMode(QAbstractItemView::SingleSelection);
-	resultsList->setContextMenuPolicy(Qt::CustomContextMenu);
-	connect(resultsList, &QListWidget::itemDoubleClicked, this, &SourceSearchDock::OnResultDoubleClicked);
-	connect(resultsList, &QListWidget::customContextMenuRequested, this, &SourceSearchDock::OnResultContextMenu);
-	mainLayout->addWidget(resultsList, 1);
+	// Results list (virtualized: rows are formatted only when visible)
+	resultsModel = new SourceResultsModel(this);
+	resultsView = new QListView(this);
+	resultsView->setModel(resultsModel);
+	resultsView->setUniformItemSizes(true);
+	resultsView->setSelectionMode(QAbstractItemView::SingleSelection);
+	resultsView->setContextMenuPolicy(Qt::CustomContextMenu);
+	connect(resultsView, &QListView::doubleClicked, this, &SourceSearchDock::OnResultDoubleClicked);
+	connect(resultsView, &QListView::customContextMenuRequested, this, &SourceSearchDock::OnResultContextMenu);
+	mainLayout->addWidget(resultsView, 1);
 
 	// Status label
 	statusLabel = new QLabel(this);
 	statusLabel->setAlignment(Qt::AlignRight);
 	mainLayout->addWidget(statusLabel);
 
+	// Optional p50/p99 timing line, toggled from the status line's menu
+	statsLabel = new QLabel(this);
+	statsLabel->setAlignment(Qt::AlignRight);
+	statsLabel->setVisible(false);
+	mainLayout->addWidget(statsLabel);
+
+	showStatsAction = new QAction(obs_module_text("ShowTimings"), this);
+	showStatsAction->setCheckable(true);
+	connect(showStatsAction, &QAction::toggled, this, [this](bool checked) {
+		statsLabel->setVisible(checked);
+		UpdateStatsLabel();
+	});
+	statusLabel->setContextMenuPolicy(Qt::ActionsContextMenu);
+	statusLabel->addAction(showStatsAction);
+
 	setLayout(mainLayout);
 }
 
@@ -129,26 +256,79 @@ void SourceSearchDock::Initialize()
 	// Don't do expensive initialization here - wait until dock is shown
 	// Just connect signals so we know when to mark as needing refresh
 	ConnectSignals();
+
+	// A new scene collection was loaded while we were disconnected
+	if (initialized) {
+		fullRefreshPending = true;
+		refreshTimer->start();
+	}
+
+	// The collection we left is one of the others now
+	if (currentSearchScope == "collections")
+		RequestCollectionScan();
 }
 
 void SourceSearchDock::showEvent(QShowEvent *event)
 {
 	QFrame::showEvent(event);
 
+	thumbnails->SetPaused(false);
+	if (thumbnails->IsRunning()) {
+		RequestVisibleThumbnails();
+		thumbnailTimer->start();
+	}
+
 	// Lazy load: only refresh sources when dock is first shown
+	LoadOnFirstUse();
+}
+
+void SourceSearchDock::LoadOnFirstUse()
+{
 	if (!initialized) {
 		initialized = true;
-		sourceCollection->Refresh();
-		UpdateTypeFilter();
-		PerformSearch();
+		statusLabel->setText(obs_module_text("LoadingSources"));
+		RequestRefresh();
 	}
 }
 
+void SourceSearchDock::hideEvent(QHideEvent *event)
+{
+	QFrame::hideEvent(event);
+
+	// Nothing runs on the render thread while nobody can see the previews
+	thumbnails->SetPaused(true);
+	thumbnailTimer->stop();
+}
+
 void SourceSearchDock::Cleanup()
 {
 	DisconnectSignals();
-	sourceCollection->Clear();
-	resultsList->clear();
+
+	// Drop any build in flight; it belongs to the old scene collection
+	++refreshGeneration;
+	refreshInFlight = false;
+	ClearPendingDeltas();
+	repaintItems.clear();
+	repaintThumbnails.clear();
+
+	// Records still in the ring refer to the old collection as well
+	SourceDelta delta;
+	while (changeRing.TryPop(delta)) {
+		ReleaseDelta(delta);
+	}
+	ringOverflowed = false;
+
+	// A search in flight belongs to the old collection too
+	++searchTicket;
+	searchInFlight = false;
+	searchTimer->stop();
+
+	// Drop the model's item pointers before the items go away
+	resultsModel->Clear();
+	{
+		auto lock = LockForChange();
+		sourceCollection->Clear();
+	}
 	typeFilter->clear();
 }
 
@@ -160,6 +340,16 @@ void SourceSearchDock::FocusSearchBox()
 	}
 }
 
+void SourceSearchDock::OnSceneListChanged()
+{
+	if (!initialized || !signalsConnected || fullRefreshPending)
+		return;
+
+	SourceDelta delta;
+	delta.kind = SourceDelta::Kind::SceneList;
+	QueueDelta(std::move(delta));
+}
+
 void SourceSearchDock::ConnectSignals()
 {
 	if (signalsConnected)
@@ -172,6 +362,14 @@ void SourceSearchDock::ConnectSignals()
 		signal_handler_connect(handler, "source_rename", OnSourceRename, this);
 		signalsConnected = true;
 	}
+
+	// Sources created from here on are picked up in OnSourceCreate
+	obs_enum_all_sources(
+		[](void *param, obs_source_t *source) {
+			static_cast<SourceSearchDock *>(param)->SetSourceSignals(source, true);
+			return true;
+		},
+		this);
 }
 
 void SourceSearchDock::DisconnectSignals()
@@ -185,45 +383,633 @@ void SourceSearchDock::DisconnectSignals()
 		signal_handler_disconnect(handler, "source_destroy", OnSourceDestroy, this);
 		signal_handler_disconnect(handler, "source_rename", OnSourceRename, this);
 	}
+
+	// Destroyed sources took their handlers with them; detach from the rest
+	obs_enum_all_sources(
+		[](void *param, obs_source_t *source) {
+			static_cast<SourceSearchDock *>(param)->SetSourceSignals(source, false);
+			return true;
+		},
+		this);
+
 	signalsConnected = false;
 }
 
+void SourceSearchDock::SetSourceSignals(obs_source_t *source, bool connect)
+{
+	signal_handler_t *handler = obs_source_get_signal_handler(source);
+	if (!handler)
+		return;
+
+	auto apply = connect ? signal_handler_connect : signal_handler_disconnect;
+
+	if (obs_source_is_scene(source) || obs_source_is_group(source)) {
+		apply(handler, "item_add", OnSceneItemAdd, this);
+		apply(handler, "item_remove", OnSceneItemRemove, this);
+	}
+
+	if (obs_source_get_type(source) != OBS_SOURCE_TYPE_FILTER) {
+		apply(handler, "filter_add", OnFilterAdd, this);
+		apply(handler, "filter_remove", OnFilterRemove, this);
+
+		// obs_enum_all_sources never visits filters, so reach the ones
+		// already attached through their parent
+		struct FilterContext {
+			SourceSearchDock *self;
+			bool connect;
+		};
+		FilterContext ctx = {this, connect};
+		obs_source_enum_filters(
+			source,
+			[](obs_source_t *, obs_source_t *filter, void *param) {
+				auto *ctx = static_cast<FilterContext *>(param);
+				ctx->self->SetSourceSignals(filter, ctx->connect);
+			},
+			&ctx);
+	}
+
+	apply(handler, "update", OnSourceUpdate, this);
+
+	// Live state shown next to results
+	for (const char *signal : {"activate", "deactivate", "show", "hide", "mute", "enable"}) {
+		apply(handler, signal, OnSourceState, this);
+	}
+}
+
+SourceSearchDock::SourceDelta SourceSearchDock::MakeDelta(SourceDelta::Kind kind, obs_source_t *source,
+							   bool keepRef)
+{
+	SourceDelta delta;
+	delta.kind = kind;
+	if (keepRef)
+		delta.weakSource = obs_source_get_weak_source(source);
+
+	const char *uuid = obs_source_get_uuid(source);
+	if (uuid) {
+		strncpy(delta.uuid, uuid, sizeof(delta.uuid) - 1);
+		delta.uuidHash = HashUUID(delta.uuid);
+	}
+	return delta;
+}
+
+uint64_t SourceSearchDock::HashUUID(const char *uuid)
+{
+	// FNV-1a; only used to spot repeats within one batch
+	uint64_t hash = 1469598103934665603ull;
+	for (const char *p = uuid; *p; p++) {
+		hash ^= static_cast<unsigned char>(*p);
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
+
 void SourceSearchDock::OnSourceCreate(void *data, calldata_t *params)
 {
-	UNUSED_PARAMETER(params);
 	SourceSearchDock *self = static_cast<SourceSearchDock *>(data);
 
-	// Only refresh if dock has been shown (initialized)
-	// Use debounce timer to coalesce rapid changes during startup
-	if (self->initialized) {
-		QMetaObject::invokeMethod(self->refreshTimer, "start", Qt::QueuedConnection);
-	}
+	obs_source_t *source = static_cast<obs_source_t *>(calldata_ptr(params, "source"));
+	if (!source)
+		return;
+
+	// Watch its scene items and filters from the start (connecting is
+	// thread-safe, and libobs ignores a second connect of the same pair)
+	self->SetSourceSignals(source, true);
+
+	// Only track changes if dock has been shown (initialized)
+	if (!self->initialized)
+		return;
+
+	// Hand a weak reference to the UI thread; released there
+	self->PostDelta(MakeDelta(SourceDelta::Kind::Create, source, true));
 }
 
 void SourceSearchDock::OnSourceDestroy(void *data, calldata_t *params)
 {
-	UNUSED_PARAMETER(params);
 	SourceSearchDock *self = static_cast<SourceSearchDock *>(data);
 
-	if (self->initialized) {
-		QMetaObject::invokeMethod(self->refreshTimer, "start", Qt::QueuedConnection);
-	}
+	if (!self->initialized)
+		return;
+
+	obs_source_t *source = static_cast<obs_source_t *>(calldata_ptr(params, "source"));
+	if (!source)
+		return;
+
+	// The source is gone by the time the UI thread runs, so key by UUID
+	SourceDelta delta = MakeDelta(SourceDelta::Kind::Destroy, source, false);
+	if (delta.uuid[0])
+		self->PostDelta(delta);
 }
 
 void SourceSearchDock::OnSourceRename(void *data, calldata_t *params)
 {
-	UNUSED_PARAMETER(params);
 	SourceSearchDock *self = static_cast<SourceSearchDock *>(data);
 
-	if (self->initialized) {
-		QMetaObject::invokeMethod(self->refreshTimer, "start", Qt::QueuedConnection);
+	if (!self->initialized)
+		return;
+
+	obs_source_t *source = static_cast<obs_source_t *>(calldata_ptr(params, "source"));
+	if (!source)
+		return;
+
+	// The UI thread reads the current name, so repeated renames collapse
+	self->PostDelta(MakeDelta(SourceDelta::Kind::Rename, source, true));
+}
+
+void SourceSearchDock::OnSceneItemAdd(void *data, calldata_t *params)
+{
+	static_cast<SourceSearchDock *>(data)->PostSceneItemDelta(params);
+}
+
+void SourceSearchDock::OnSceneItemRemove(void *data, calldata_t *params)
+{
+	// Same relink as an add: the UI thread asks the scene what it holds
+	static_cast<SourceSearchDock *>(data)->PostSceneItemDelta(params);
+}
+
+void SourceSearchDock::PostSceneItemDelta(calldata_t *params)
+{
+	if (!initialized)
+		return;
+
+	obs_scene_t *scene = static_cast<obs_scene_t *>(calldata_ptr(params, "scene"));
+	obs_sceneitem_t *item = static_cast<obs_sceneitem_t *>(calldata_ptr(params, "item"));
+	if (!scene || !item)
+		return;
+
+	obs_source_t *sceneSource = obs_scene_get_source(scene);
+	obs_source_t *itemSource = obs_sceneitem_get_source(item);
+	if (!sceneSource || !itemSource)
+		return;
+
+	SourceDelta delta = MakeDelta(SourceDelta::Kind::SceneItem, sceneSource, true);
+	delta.weakItem = obs_source_get_weak_source(itemSource);
+	const char *itemUuid = obs_source_get_uuid(itemSource);
+	if (itemUuid)
+		delta.itemHash = HashUUID(itemUuid);
+	PostDelta(delta);
+}
+
+void SourceSearchDock::OnFilterAdd(void *data, calldata_t *params)
+{
+	SourceSearchDock *self = static_cast<SourceSearchDock *>(data);
+
+	obs_source_t *filter = static_cast<obs_source_t *>(calldata_ptr(params, "filter"));
+	if (!filter)
+		return;
+
+	// Its enable/update signals, in case it was created before we connected
+	self->SetSourceSignals(filter, true);
+
+	if (!self->initialized)
+		return;
+
+	// Filters are attached after source_create, so insert them now that
+	// obs_filter_get_parent() knows where they belong
+	self->PostDelta(MakeDelta(SourceDelta::Kind::Create, filter, true));
+}
+
+void SourceSearchDock::OnFilterRemove(void *data, calldata_t *params)
+{
+	SourceSearchDock *self = static_cast<SourceSearchDock *>(data);
+
+	if (!self->initialized)
+		return;
+
+	obs_source_t *filter = static_cast<obs_source_t *>(calldata_ptr(params, "filter"));
+	if (!filter)
+		return;
+
+	// A detached filter may linger (undo) but no longer belongs to anything
+	SourceDelta delta = MakeDelta(SourceDelta::Kind::Destroy, filter, false);
+	if (delta.uuid[0])
+		self->PostDelta(delta);
+}
+
+void SourceSearchDock::OnSourceUpdate(void *data, calldata_t *params)
+{
+	SourceSearchDock *self = static_cast<SourceSearchDock *>(data);
+
+	// Settings only matter while deep search is on
+	if (!self->initialized || !self->deepSearchEnabled)
+		return;
+
+	obs_source_t *source = static_cast<obs_source_t *>(calldata_ptr(params, "source"));
+	if (!source)
+		return;
+
+	// Only this source is re-extracted; repeated updates collapse
+	self->PostDelta(MakeDelta(SourceDelta::Kind::Settings, source, true));
+}
+
+void SourceSearchDock::OnSourceState(void *data, calldata_t *params)
+{
+	SourceSearchDock *self = static_cast<SourceSearchDock *>(data);
+
+	if (!self->initialized)
+		return;
+
+	obs_source_t *source = static_cast<obs_source_t *>(calldata_ptr(params, "source"));
+	if (!source)
+		return;
+
+	// The UI thread reads all four bits, so a show/hide pair collapses
+	self->PostDelta(MakeDelta(SourceDelta::Kind::State, source, true));
+}
+
+void SourceSearchDock::PostDelta(const SourceDelta &delta)
+{
+	if (!changeRing.TryPush(delta)) {
+		// Too many changes to follow one by one; the drain rebuilds instead
+		SourceDelta dropped = delta;
+		ReleaseDelta(dropped);
+		ringOverflowed = true;
+	}
+
+	// One queued call per batch: only the first record since the last
+	// drain schedules one
+	if (!drainScheduled.exchange(true))
+		QMetaObject::invokeMethod(this, [this]() { DrainDeltas(); }, Qt::QueuedConnection);
+}
+
+void SourceSearchDock::DrainDeltas()
+{
+	// Clear first so records pushed while draining schedule another pass
+	drainScheduled = false;
+
+	std::vector<SourceDelta> batch;
+	SourceDelta delta;
+	while (changeRing.TryPop(delta)) {
+		batch.push_back(delta);
+	}
+
+	if (ringOverflowed.exchange(false)) {
+		for (auto &dropped : batch) {
+			ReleaseDelta(dropped);
+		}
+
+		if (initialized && signalsConnected && !fullRefreshPending) {
+			blog(LOG_INFO, "[Source Search] Change queue overflowed, rebuilding the source list");
+			fullRefreshPending = true;
+			refreshTimer->start();
+		}
+		return;
+	}
+
+	// Renames, relinks, settings and state re-read libobs when applied, so
+	// of repeats to the same source only the last counts (it also comes
+	// after any create it depends on). Creates and destroys are never
+	// merged: undo can destroy and re-create a UUID within one batch, and
+	// only the last create still holds a live source.
+	std::unordered_set<uint64_t> seen;
+	seen.reserve(batch.size());
+	std::vector<bool> repeated(batch.size(), false);
+	for (size_t i = batch.size(); i-- > 0;) {
+		const SourceDelta &change = batch[i];
+		if (change.kind == SourceDelta::Kind::Create || change.kind == SourceDelta::Kind::Destroy)
+			continue;
+
+		uint64_t key = (change.uuidHash ^ (change.itemHash * 0x9E3779B97F4A7C15ull)) +
+			       static_cast<uint64_t>(change.kind);
+		repeated[i] = !seen.insert(key).second;
+	}
+
+	for (size_t i = 0; i < batch.size(); i++) {
+		if (repeated[i])
+			ReleaseDelta(batch[i]);
+		else
+			QueueDelta(batch[i]);
+	}
+}
+
+void SourceSearchDock::QueueDelta(SourceDelta delta)
+{
+	// Dropped if the collection was torn down or is about to be rebuilt
+	if (!signalsConnected || fullRefreshPending) {
+		ReleaseDelta(delta);
+		return;
+	}
+
+	if (delta.kind == SourceDelta::Kind::State) {
+		// Not searched: no lock, no new search, just a repaint of the row
+		obs_source_t *source = obs_weak_source_get_source(delta.weakSource);
+		SourceItem *item = source ? sourceCollection->UpdateLiveState(source) : nullptr;
+		obs_source_release(source);
+		if (item) {
+			repaintItems.insert(item);
+			if (!repaintTimer->isActive())
+				repaintTimer->start();
+		}
+	} else {
+		bool changed;
+		{
+			auto lock = LockForChange();
+			changed = ApplyDelta(*sourceCollection, delta);
+		}
+		if (changed)
+			refreshTimer->start();
+	}
+
+	// A background build may have enumerated before this change
+	if (refreshInFlight) {
+		pendingDeltas.push_back(std::move(delta));
+		return;
+	}
+
+	ReleaseDelta(delta);
+}
+
+bool SourceSearchDock::ApplyDelta(SourceCollection &collection, const SourceDelta &delta)
+{
+	switch (delta.kind) {
+	case SourceDelta::Kind::Destroy:
+		return collection.RemoveSource(delta.uuid);
+
+	case SourceDelta::Kind::SceneList:
+		// Only redraw if a scene moved between the main and vertical canvas
+		return collection.UpdateCanvasMembership();
+
+	case SourceDelta::Kind::SceneItem: {
+		obs_source_t *scene = obs_weak_source_get_source(delta.weakSource);
+		obs_source_t *item = obs_weak_source_get_source(delta.weakItem);
+
+		// Only this source's membership in this scene is re-checked
+		bool changed = scene && item && collection.RelinkSceneItem(scene, item);
+		obs_source_release(item);
+		obs_source_release(scene);
+		return changed;
+	}
+
+	case SourceDelta::Kind::State: {
+		// Replayed onto a build that may have read the state before it changed
+		obs_source_t *source = obs_weak_source_get_source(delta.weakSource);
+		if (source)
+			collection.UpdateLiveState(source);
+		obs_source_release(source);
+		return false;
+	}
+
+	case SourceDelta::Kind::Settings: {
+		obs_source_t *source = obs_weak_source_get_source(delta.weakSource);
+		bool changed = source && collection.UpdateSettingsText(source);
+		obs_source_release(source);
+		return changed;
+	}
+
+	case SourceDelta::Kind::Create:
+	case SourceDelta::Kind::Rename: {
+		obs_source_t *source = obs_weak_source_get_source(delta.weakSource);
+		if (!source)
+			return false;
+
+		bool changed = delta.kind == SourceDelta::Kind::Create
+				       ? collection.InsertSource(source)
+				       : collection.RenameSource(source);
+		obs_source_release(source);
+		return changed;
+	}
+	}
+
+	return false;
+}
+
+void SourceSearchDock::ReleaseDelta(SourceDelta &delta)
+{
+	if (delta.weakSource) {
+		obs_weak_source_release(delta.weakSource);
+		delta.weakSource = nullptr;
 	}
+	if (delta.weakItem) {
+		obs_weak_source_release(delta.weakItem);
+		delta.weakItem = nullptr;
+	}
+}
+
+void SourceSearchDock::RepaintChangedRows()
+{
+	resultsModel->RepaintItems(repaintItems);
+	repaintItems.clear();
+	resultsModel->RepaintThumbnails(repaintThumbnails);
+	repaintThumbnails.clear();
+}
+
+void SourceSearchDock::ClearPendingDeltas()
+{
+	for (auto &delta : pendingDeltas) {
+		ReleaseDelta(delta);
+	}
+	pendingDeltas.clear();
+}
+
+void SourceSearchDock::RequestRefresh()
+{
+	fullRefreshPending = false;
+	refreshInFlight = true;
+	uint64_t generation = ++refreshGeneration;
+
+	// Changes recorded for an older build are covered by this one
+	ClearPendingDeltas();
+
+	// Frontend calls must stay on the UI thread; the rest runs on the worker
+	auto mainScenes = SourceCollection::CaptureMainScenes();
+	QString snapshotPath = SnapshotPath();
+
+	// Nothing to show yet (startup, collection switch): show the last index
+	// right away. Its rows are only bound to sources by UUID; the live build
+	// below resolves every source and replaces them in OnRefreshBuilt
+	if (sourceCollection->GetSources().empty() && !snapshotPath.isEmpty() && LoadSnapshot(snapshotPath)) {
+		UpdateTypeFilter();
+		PerformSearch();
+	}
+
+	refreshPool->start([this, generation, mainScenes, snapshotPath]() {
+		auto built = std::make_shared<SourceCollection>();
+		built->Refresh(mainScenes);
+
+		if (!snapshotPath.isEmpty()) {
+			std::string data = built->SaveSnapshot();
+			QSaveFile file(snapshotPath);
+			if (file.open(QIODevice::WriteOnly) &&
+			    file.write(data.data(), static_cast<qint64>(data.size())) == static_cast<qint64>(data.size()))
+				file.commit();
+			else
+				blog(LOG_WARNING, "[Source Search] Could not write index snapshot");
+		}
+
+		QMetaObject::invokeMethod(
+			this, [this, generation, built]() { OnRefreshBuilt(generation, built); },
+			Qt::QueuedConnection);
+	});
+}
+
+void SourceSearchDock::OnRefreshBuilt(uint64_t generation, std::shared_ptr<SourceCollection> built)
+{
+	// A newer refresh was requested, or the scene collection was unloaded
+	if (generation != refreshGeneration)
+		return;
+
+	refreshInFlight = false;
+
+	// Apply changes that raced with the enumeration
+	for (auto &delta : pendingDeltas) {
+		ApplyDelta(*built, delta);
+	}
+	ClearPendingDeltas();
+
+	RecordRefreshTimings(*built);
+
+	// Keep the old items alive until the model has switched over
+	std::shared_ptr<SourceCollection> previous;
+	{
+		auto lock = LockForChange();
+		previous = std::move(sourceCollection);
+		sourceCollection = std::move(built);
+		sourceCollection->PurgeRemoved();
+	}
+	UpdateTypeFilter();
+
+	// Removed items are released once the new results are shown
+	PerformSearch();
+
+	StartSettingsIndex();
+}
+
+void SourceSearchDock::StartSettingsIndex()
+{
+	// Restored rows would each need a lookup here; OnRefreshBuilt starts
+	// the job for the live build instead
+	if (!deepSearchEnabled || refreshInFlight || sourceCollection->HasSettingsIndex() ||
+	    settingsJobFor.lock() == sourceCollection)
+		return;
+
+	// Weak references go to the worker, which also releases them
+	settingsJobFor = sourceCollection;
+	auto targets = std::make_shared<std::vector<SourceCollection::SettingsTarget>>(
+		sourceCollection->GetSettingsTargets());
+	std::weak_ptr<SourceCollection> target = sourceCollection;
+
+	refreshPool->start([this, target, targets]() {
+		uint64_t start = LatencyNow();
+
+		std::vector<SourceCollection::SettingsText> texts;
+		texts.reserve(targets->size());
+		for (auto &entry : *targets) {
+			obs_source_t *source = obs_weak_source_get_source(entry.weakSource);
+			obs_weak_source_release(entry.weakSource);
+			if (!source)
+				continue;
+
+			texts.push_back({std::move(entry.uuid), SourceCollection::ExtractSettingsText(source)});
+			obs_source_release(source);
+		}
+
+		uint64_t extractNs = LatencyNow() - start;
+		QMetaObject::invokeMethod(
+			this,
+			[this, target, texts = std::move(texts), extractNs]() mutable {
+				OnSettingsExtracted(target, std::move(texts), extractNs);
+			},
+			Qt::QueuedConnection);
+	});
+}
+
+void SourceSearchDock::OnSettingsExtracted(std::weak_ptr<SourceCollection> target,
+					   std::vector<SourceCollection::SettingsText> texts, uint64_t extractNs)
+{
+	std::shared_ptr<SourceCollection> collection = target.lock();
+	if (settingsJobFor.lock() == collection)
+		settingsJobFor.reset();
+
+	// Replaced by a newer build (which runs its own job), or switched off
+	if (!collection || collection != sourceCollection || !deepSearchEnabled)
+		return;
+
+	{
+		auto lock = LockForChange();
+		sourceCollection->ApplySettingsTexts(texts, extractNs);
+	}
+	PerformSearch();
+}
+
+QString SourceSearchDock::SnapshotPath()
+{
+	char *collection = obs_frontend_get_current_scene_collection();
+	if (!collection)
+		return QString();
+
+	char fileName[32];
+	snprintf(fileName, sizeof(fileName), "index-%016llx.bin",
+		 static_cast<unsigned long long>(HashUUID(collection)));
+	bfree(collection);
+
+	char *path = obs_module_config_path(fileName);
+	if (!path)
+		return QString();
+
+	QString result = QString::fromUtf8(path);
+	bfree(path);
+
+	QDir().mkpath(QFileInfo(result).absolutePath());
+	return result;
+}
+
+bool SourceSearchDock::LoadSnapshot(const QString &path)
+{
+	QFile file(path);
+	if (!file.open(QIODevice::ReadOnly) || file.size() == 0)
+		return false;
+
+	const uchar *data = file.map(0, file.size());
+	if (!data)
+		return false;
+
+	SnapshotReader reader;
+	if (!reader.Open(data, static_cast<size_t>(file.size()))) {
+		blog(LOG_WARNING, "[Source Search] Ignoring invalid index snapshot");
+		return false;
+	}
+
+	auto restored = std::make_shared<SourceCollection>();
+	bool loaded = restored->LoadSnapshot(reader);
+	file.unmap(const_cast<uchar *>(data));
+
+	if (!loaded)
+		return false;
+
+	std::shared_ptr<SourceCollection> previous;
+	{
+		auto lock = LockForChange();
+		previous = std::move(sourceCollection);
+		sourceCollection = std::move(restored);
+	}
+	return true;
 }
 
 void SourceSearchDock::OnSearchTextChanged(const QString &text)
 {
 	currentSearchText = text;
-	searchTimer->start();  // Restart debounce timer
+
+	// The first keystroke after a pause runs right away; while typing,
+	// wait about as long as a search takes
+	uint64_t now = LatencyNow();
+	bool idle = !searchInFlight && !searchTimer->isActive() && now - lastKeystroke > kTypingIdleNs;
+	lastKeystroke = now;
+
+	if (idle) {
+		PerformSearch();
+		return;
+	}
+
+	searchTimer->start(DebounceInterval());  // Restart debounce timer
+}
+
+int SourceSearchDock::DebounceInterval() const
+{
+	const LatencyWindow &window = latencyStats.Window(TimedStage::Search);
+	if (window.Samples() == 0)
+		return kMaxDebounceMs;
+
+	int ms = static_cast<int>(window.Percentile(90) * 2 / 1000000);
+	return std::clamp(ms, kMinDebounceMs, kMaxDebounceMs);
 }
 
 void SourceSearchDock::OnSearchScopeChanged(int index)
@@ -232,9 +1018,85 @@ void SourceSearchDock::OnSearchScopeChanged(int index)
 		return;
 
 	currentSearchScope = searchScope->itemData(index).toString();
+
+	// Files are checked again each time the scope is picked
+	if (currentSearchScope == "collections")
+		RequestCollectionScan();
+
+	PerformSearch();
+}
+
+void SourceSearchDock::OnSearchModeChanged(int index)
+{
+	if (index < 0)
+		return;
+
+	currentSearchMode = searchMode->itemData(index).toString();
+	PerformSearch();
+}
+
+void SourceSearchDock::OnDeepSearchToggled(bool enabled)
+{
+	deepSearchEnabled = enabled;
+
+	if (enabled) {
+		StartSettingsIndex();
+		return;
+	}
+
+	// Give the memory back; the next enable extracts again
+	settingsJobFor.reset();
+	{
+		auto lock = LockForChange();
+		sourceCollection->ClearSettingsIndex();
+	}
 	PerformSearch();
 }
 
+void SourceSearchDock::OnThumbnailsToggled(bool enabled)
+{
+	thumbnails->SetEnabled(enabled);
+	resultsView->setIconSize(enabled ? QSize(ThumbnailCache::kWidth, ThumbnailCache::kHeight) : QSize());
+	resultsModel->SetThumbnails(enabled ? thumbnails : nullptr);
+
+	if (thumbnails->IsRunning()) {
+		RequestVisibleThumbnails();
+		thumbnailTimer->start();
+	} else {
+		thumbnails->Request({});
+		thumbnailTimer->stop();
+	}
+}
+
+void SourceSearchDock::RequestVisibleThumbnails()
+{
+	if (!thumbnails->IsRunning())
+		return;
+
+	// Only the rows on screen, top to bottom
+	QModelIndex top = resultsView->indexAt(QPoint(0, 0));
+	int first = top.isValid() ? top.row() : 0;
+	int rows = resultsModel->rowCount();
+	int rowHeight = std::max(1, resultsView->visualRect(top).height());
+	int last = std::min(rows - 1, first + resultsView->viewport()->height() / rowHeight + 1);
+
+	std::vector<obs_source_t *> sources;
+	for (int row = first; row <= last; row++) {
+		SourceItem *item = resultsModel->ItemAt(resultsModel->index(row));
+		if (!item || item->IsFilter())
+			continue;
+
+		obs_source_t *source = item->GetSource();
+		if (source)
+			sources.push_back(source);
+	}
+
+	thumbnails->Request(sources);
+	for (obs_source_t *source : sources) {
+		obs_source_release(source);
+	}
+}
+
 void SourceSearchDock::OnTypeFilterChanged(int index)
 {
 	if (index < 0)
@@ -246,8 +1108,21 @@ void SourceSearchDock::OnTypeFilterChanged(int index)
 
 void SourceSearchDock::OnSourcesChanged()
 {
-	sourceCollection->Refresh();
+	// Keep showing the current results until the rebuilt collection lands
+	if (fullRefreshPending) {
+		RequestRefresh();
+		return;
+	}
+
+	// Compact rows tombstoned since the last tick
+	{
+		auto lock = LockForChange();
+		sourceCollection->PurgeRemoved();
+	}
+
 	UpdateTypeFilter();
+
+	// Removed items are released once the new results are shown
 	PerformSearch();
 }
 
@@ -258,30 +1133,46 @@ void SourceSearchDock::PerformSearch()
 
 void SourceSearchDock::UpdateTypeFilter()
 {
-	// Save current selection
-	QString currentSelection = currentTypeFilter;
+	// Nothing to do while the type set stays the same
+	const TypeRegistry &types = sourceCollection->GetTypes();
+	if (typeFilter->count() > 0 && typesShownFor.lock() == sourceCollection &&
+	    typesShownVersion == types.Version())
+		return;
+
+	typesShownFor = sourceCollection;
+	typesShownVersion = types.Version();
 
 	typeFilter->blockSignals(true);
-	typeFilter->clear();
 
 	// Add "All" option
-	typeFilter->addItem(obs_module_text("AllTypes"), "all");
+	if (typeFilter->count() == 0)
+		typeFilter->addItem(obs_module_text("AllTypes"), "all");
+
+	// Drop types that are gone
+	std::unordered_set<std::string> shown;
+	for (int i = typeFilter->count() - 1; i >= 1; i--) {
+		std::string typeId = typeFilter->itemData(i).toString().toStdString();
+		if (types.Contains(typeId))
+			shown.insert(std::move(typeId));
+		else
+			typeFilter->removeItem(i);
+	}
 
-	// Add discovered types, sorted by display name
-	const auto &types = sourceCollection->GetDiscoveredTypes();
-	std::vector<std::pair<std::string, std::string>> sortedTypes(types.begin(), types.end());
-	std::sort(sortedTypes.begin(), sortedTypes.end(),
-		  [](const auto &a, const auto &b) {
-			  return a.second < b.second;
-		  });
+	// Insert new types at their place in display name order
+	for (const auto &[typeId, count] : types.Counts()) {
+		if (shown.count(typeId))
+			continue;
 
-	for (const auto &[typeId, displayName] : sortedTypes) {
-		typeFilter->addItem(QString::fromStdString(displayName),
-				    QString::fromStdString(typeId));
+		std::string displayName = GetTypeDisplayName(typeId);
+		int pos = 1;
+		while (pos < typeFilter->count() && typeFilter->itemText(pos).toStdString() <= displayName) {
+			pos++;
+		}
+		typeFilter->insertItem(pos, QString::fromStdString(displayName), QString::fromStdString(typeId));
 	}
 
-	// Restore selection
-	int index = typeFilter->findData(currentSelection);
+	// Keep the selection unless its type went away
+	int index = typeFilter->findData(currentTypeFilter);
 	if (index >= 0) {
 		typeFilter->setCurrentIndex(index);
 	} else {
@@ -294,72 +1185,324 @@ void SourceSearchDock::UpdateTypeFilter()
 
 void SourceSearchDock::UpdateResults()
 {
-	resultsList->clear();
-
 	std::string searchText = currentSearchText.toStdString();
 	std::string typeFilterStr = currentTypeFilter.toStdString();
-	std::string scopeStr = currentSearchScope.toStdString();
 
-	auto results = sourceCollection->Search(searchText, typeFilterStr);
+	// Scope and orphan filtering happen inside the index scan
+	SearchScope scope = SearchScope::Sources;
+	if (currentSearchScope == "filters")
+		scope = SearchScope::Filters;
+	else if (currentSearchScope == "all")
+		scope = SearchScope::All;
 
-	int count = 0;
-	for (SourceItem *item : results) {
-		// Filter by search scope
-		bool isFilter = item->IsFilter();
-		if (scopeStr == "sources" && isFilter)
-			continue;
-		if (scopeStr == "filters" && !isFilter)
-			continue;
+	SearchMode mode = currentSearchMode == "fuzzy" ? SearchMode::Fuzzy : SearchMode::Contains;
 
-		// Skip sources that aren't in any scene (internal OBS sources)
-		// But keep scenes, groups, and filters
-		if (!isFilter && !item->IsScene() && !item->IsGroup()) {
-			const auto &parents = item->GetParentScenes();
-			if (parents.empty())
-				continue;
-		}
+	searchTimer->stop();
 
-		// Create display text
-		QString displayText = QString::fromStdString(item->GetDisplayName());
+	if (currentSearchScope == "collections") {
+		// Cheap and read-only; also supersedes a live search in flight
+		++searchTicket;
+		searchInFlight = false;
+		UpdateOtherResults(ParseSearchQuery(searchText), typeFilterStr, mode);
+		return;
+	}
 
-		// Add type info
-		displayText += QString(" [%1]").arg(QString::fromStdString(item->GetTypeDisplayName()));
+	StartSearch(std::move(searchText), std::move(typeFilterStr), scope, mode);
+}
 
-		// For filters, show what source they're on
-		if (isFilter) {
-			std::string parentSource = item->GetParentSourceName();
-			if (!parentSource.empty()) {
-				displayText += QString(" on: %1").arg(QString::fromStdString(parentSource));
-			}
-		} else {
-			// Add parent scenes for regular sources
-			const auto &parents = item->GetParentScenes();
-			if (!parents.empty()) {
-				QStringList parentList;
-				for (const auto &parent : parents) {
-					parentList.append(QString::fromStdString(parent));
-				}
-				displayText += QString(" in: %1").arg(parentList.join(", "));
-			}
+void SourceSearchDock::StartSearch(std::string searchText, std::string typeFilter, SearchScope scope,
+				   SearchMode mode)
+{
+	// A newer ticket makes the running scan stop at its next check
+	uint64_t ticket = ++searchTicket;
+	searchInFlight = true;
+	std::shared_ptr<SourceCollection> collection = sourceCollection;
+
+	searchPool->start([this, ticket, collection, searchText = std::move(searchText),
+			   typeFilter = std::move(typeFilter), scope, mode]() {
+		CancelToken cancel(&searchTicket, ticket);
+		if (cancel.Cancelled())
+			return;
+
+		uint64_t start = LatencyNow();
+		uint64_t generation;
+		std::vector<SourceItem *> results;
+		{
+			std::shared_lock<std::shared_mutex> lock(collectionMutex);
+			generation = collection->Generation();
+			results = collection->Search(searchText, typeFilter, scope, mode, cancel);
 		}
+		uint64_t searchNs = LatencyNow() - start;
+
+		// Whoever cancelled it starts the next one
+		if (cancel.Cancelled())
+			return;
+
+		QMetaObject::invokeMethod(
+			this,
+			[this, ticket, collection, generation, results = std::move(results), searchNs]() mutable {
+				OnSearchFinished(ticket, collection, generation, std::move(results), searchNs);
+			},
+			Qt::QueuedConnection);
+	});
+}
+
+void SourceSearchDock::OnSearchFinished(uint64_t ticket, std::shared_ptr<SourceCollection> collection,
+					uint64_t generation, std::vector<SourceItem *> results, uint64_t searchNs)
+{
+	// Superseded while queued
+	if (ticket != searchTicket)
+		return;
 
-		QListWidgetItem *listItem = new QListWidgetItem(displayText, resultsList);
-		listItem->setData(Qt::UserRole, QVariant::fromValue(static_cast<void *>(item)));
-		count++;
+	searchInFlight = false;
+
+	// The rows changed after the scan (items may be gone): search again
+	if (collection != sourceCollection || generation != collection->Generation()) {
+		PerformSearch();
+		return;
 	}
 
+	uint64_t populateStart = LatencyNow();
+	size_t count = results.size();
+
+	// Row text is built lazily by the model for visible rows only
+	resultsModel->SetResults(sourceCollection, std::move(results));
+
 	// Update status
 	statusLabel->setText(QString("%1 %2")
 				.arg(count)
 				.arg(obs_module_text("ResultsFound")));
+
+	// The model no longer points at removed items
+	{
+		auto lock = LockForChange();
+		sourceCollection->ReleaseRemoved();
+	}
+
+	latencyStats.Record(TimedStage::Search, searchNs);
+	latencyStats.Record(TimedStage::Populate, LatencyNow() - populateStart);
+	UpdateStatsLabel();
+}
+
+SourceSearchDock::RemoteResult SourceSearchDock::RunRemoteQuery(const RemoteQuery &query)
+{
+	// Nothing is indexed until first use; start loading for the next request
+	if (!initialized) {
+		QMetaObject::invokeMethod(this, [this]() { LoadOnFirstUse(); }, Qt::QueuedConnection);
+		return RemoteResult::Loading;
+	}
+
+	// A change on the UI thread cancels the scan; run it again after
+	for (int attempt = 0; attempt < kRemoteQueryAttempts; attempt++) {
+		struct Job {
+			std::mutex mutex;
+			std::condition_variable finished;
+			bool running = false;
+			bool done = false;
+			bool abandoned = false;
+			bool completed = false;
+		};
+		auto job = std::make_shared<Job>();
+
+		// Behind the dock's own search: searches share the query caches
+		searchPool->start([this, job, &query]() {
+			std::unique_lock<std::mutex> jobLock(job->mutex);
+			if (job->abandoned)
+				return;
+			job->running = true;
+			jobLock.unlock();
+
+			bool completed;
+			{
+				std::shared_lock<std::shared_mutex> lock(collectionMutex);
+				CancelToken cancel(&remoteTicket, remoteTicket.load());
+				completed = query(*sourceCollection, cancel);
+			}
+
+			jobLock.lock();
+			job->done = true;
+			job->completed = completed;
+			job->finished.notify_one();
+		});
+
+		std::unique_lock<std::mutex> jobLock(job->mutex);
+		if (!job->finished.wait_for(jobLock, std::chrono::milliseconds(kRemoteQueryTimeoutMs),
+					    [&job]() { return job->done; })) {
+			// Still queued: it must never run once we return
+			if (!job->running) {
+				job->abandoned = true;
+				return RemoteResult::Busy;
+			}
+
+			// Running with references into our caller: stop it and wait
+			++remoteTicket;
+			job->finished.wait(jobLock, [&job]() { return job->done; });
+			return job->completed ? RemoteResult::Done : RemoteResult::Busy;
+		}
+
+		if (job->completed)
+			return RemoteResult::Done;
+	}
+
+	return RemoteResult::Busy;
+}
+
+std::unique_lock<std::shared_mutex> SourceSearchDock::LockForChange()
+{
+	// Remote queries are run again by their caller
+	++remoteTicket;
+
+	// Rather than wait out a long scan, stop it and search again after
+	if (searchInFlight) {
+		++searchTicket;
+		searchInFlight = false;
+		searchTimer->start(0);
+	}
+
+	return std::unique_lock<std::shared_mutex>(collectionMutex);
+}
+
+void SourceSearchDock::UpdateOtherResults(const SearchQuery &query, const std::string &typeFilter,
+					  SearchMode mode)
+{
+	uint64_t searchStart = LatencyNow();
+
+	// The loaded collection is searched live by the other scopes
+	std::string current;
+	if (char *name = obs_frontend_get_current_scene_collection()) {
+		current = name;
+		bfree(name);
+	}
+
+	std::vector<CollectionCache::Entry> owners;
+	std::vector<SourceResultsModel::OtherRow> rows;
+	std::vector<SourceIndex::Row> matches;
+
+	// Collections in name order, each one's rows in its own order
+	std::vector<CollectionCache::Entry> sorted;
+	for (const auto &[path, entry] : otherCollections) {
+		if (entry->file.name != current)
+			sorted.push_back(entry);
+	}
+	std::sort(sorted.begin(), sorted.end(),
+		  [](const auto &a, const auto &b) { return a->file.name < b->file.name; });
+
+	for (const auto &entry : sorted) {
+		// Scene and parent terms resolve against the file's own entries
+		std::vector<uint64_t> nameRows;
+		if (query.HasNameTerms())
+			nameRows = CollectionNameTermRows(entry->file, entry->scenes, query);
+
+		IndexSearch search;
+		search.Run(entry->index, query, typeFilter, SearchScope::All, mode, matches,
+			   query.HasNameTerms() ? &nameRows : nullptr);
+		if (matches.empty())
+			continue;
+
+		owners.push_back(entry);
+		for (SourceIndex::Row row : matches) {
+			rows.push_back({entry.get(), row});
+		}
+	}
+
+	size_t count = rows.size();
+	uint64_t searchEnd = LatencyNow();
+	resultsModel->SetOtherResults(std::move(owners), std::move(rows));
+
+	// The model no longer points at removed items
+	{
+		auto lock = LockForChange();
+		sourceCollection->ReleaseRemoved();
+	}
+
+	QString status = QString("%1 %2").arg(count).arg(obs_module_text("ResultsFound"));
+	if (collectionScanInFlight)
+		status = QString("%1 (%2)").arg(status).arg(obs_module_text("ScanningCollections"));
+	statusLabel->setText(status);
+
+	latencyStats.Record(TimedStage::Search, searchEnd - searchStart);
+	latencyStats.Record(TimedStage::Populate, LatencyNow() - searchEnd);
+	UpdateStatsLabel();
+}
+
+void SourceSearchDock::RequestCollectionScan()
+{
+	// One scan at a time; a request during a scan runs once it's done
+	if (collectionScanInFlight) {
+		collectionScanQueued = true;
+		return;
+	}
+
+	QString directory = CollectionCache::CollectionsDirectory();
+	if (directory.isEmpty())
+		return;
+
+	collectionScanInFlight = true;
+	collectionScanQueued = false;
+
+	CollectionCache::Files previous = otherCollections;
+	refreshPool->start([this, directory, previous]() {
+		CollectionCache::ScanStats stats;
+		CollectionCache::Files files = CollectionCache::Rescan(directory, previous, stats);
+
+		QMetaObject::invokeMethod(
+			this,
+			[this, files = std::move(files), stats]() mutable {
+				OnCollectionsScanned(std::move(files), stats);
+			},
+			Qt::QueuedConnection);
+	});
+}
+
+void SourceSearchDock::OnCollectionsScanned(CollectionCache::Files files, CollectionCache::ScanStats stats)
+{
+	collectionScanInFlight = false;
+	otherCollections = std::move(files);
+
+	blog(LOG_INFO, "[Source Search] Scene collection files: %zu parsed, %zu unchanged, %zu unreadable, %.1f ms",
+	     stats.parsed, stats.reused, stats.failed, static_cast<double>(stats.elapsedNs) / 1e6);
+
+	if (collectionScanQueued) {
+		RequestCollectionScan();
+		return;
+	}
+
+	if (currentSearchScope == "collections")
+		PerformSearch();
+}
+
+void SourceSearchDock::RecordRefreshTimings(const SourceCollection &collection)
+{
+	const auto &timings = collection.GetRefreshTimings();
+	if (timings.total == 0)
+		return;
+
+	latencyStats.Record(TimedStage::RefreshEnumerate, timings.enumerate);
+	latencyStats.Record(TimedStage::RefreshFilters, timings.filters);
+	latencyStats.Record(TimedStage::RefreshSceneItems, timings.sceneItems);
+	latencyStats.Record(TimedStage::RefreshTotal, timings.total);
 }
 
-void SourceSearchDock::OnResultDoubleClicked(QListWidgetItem *listItem)
+void SourceSearchDock::UpdateStatsLabel()
 {
-	if (!listItem)
+	if (!showStatsAction->isChecked())
 		return;
 
-	SourceItem *item = static_cast<SourceItem *>(listItem->data(Qt::UserRole).value<void *>());
+	statsLabel->setText(QString::fromStdString(latencyStats.Summary()));
+}
+
+void SourceSearchDock::LogStats()
+{
+	if (latencyStats.Recorded() == statsLogged)
+		return;
+
+	statsLogged = latencyStats.Recorded();
+	blog(LOG_INFO, "[Source Search] Timings p50/p99: %s", latencyStats.Summary().c_str());
+}
+
+void SourceSearchDock::OnResultDoubleClicked(const QModelIndex &index)
+{
+	SourceItem *item = resultsModel->ItemAt(index);
 	if (!item)
 		return;
 
@@ -369,11 +1512,7 @@ void SourceSearchDock::OnResultDoubleClicked(QListWidgetItem *listItem)
 
 void SourceSearchDock::OnResultContextMenu(const QPoint &pos)
 {
-	QListWidgetItem *listItem = resultsList->itemAt(pos);
-	if (!listItem)
-		return;
-
-	SourceItem *item = static_cast<SourceItem *>(listItem->data(Qt::UserRole).value<void *>());
+	SourceItem *item = resultsModel->ItemAt(resultsView->indexAt(pos));
 	if (!item)
 		return;
 
@@ -389,7 +1528,15 @@ void SourceSearchDock::OnResultContextMenu(const QPoint &pos)
 		OpenSourceFilters(item);
 	});
 
-	menu.exec(resultsList->mapToGlobal(pos));
+	// List this source's filters as results (a filter-on: query)
+	if (!item->IsFilter() && !sourceCollection->GetFilters(item).empty()) {
+		QAction *showFiltersAction = menu.addAction(obs_module_text("ShowFilters"));
+		connect(showFiltersAction, &QAction::triggered, [this, item]() {
+			searchBox->setText(QString("filter-on:\"%1\"").arg(QString::fromStdString(item->GetName())));
+		});
+	}
+
+	menu.exec(resultsView->viewport()->mapToGlobal(pos));
 }
 
 void SourceSearchDock::OpenSourceProperties(SourceItem *item)
@@ -13,14 +13,29 @@
 #include <QFrame>
 #include <QLineEdit>
 #include <QComboBox>
-#include <QListWidget>
+#include <QCheckBox>
+#include <QListView>
 #include <QVBoxLayout>
 #include <QLabel>
 #include <QTimer>
+#include <QThreadPool>
+#include <QAction>
 
+#include <atomic>
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
 
+#include "collection-cache.hpp"
+#include "latency-stats.hpp"
+#include "mpsc-ring.hpp"
+#include "scan-pool.hpp"
 #include "source-item.hpp"
+#include "source-results-model.hpp"
+#include "thumbnail-cache.hpp"
 
 class SourceSearchDock : public QFrame {
 	Q_OBJECT
@@ -38,25 +53,67 @@ public:
 	// Focus the search box (for hotkey)
 	void FocusSearchBox();
 
+	// Frontend scene list changed (scenes added, removed or reordered)
+	void OnSceneListChanged();
+
+	// Any thread (obs-websocket requests): run a read-only query on the
+	// current collection and wait for it. The query returns false if it
+	// was cancelled (and then must not have written anything); a change
+	// to the collection cancels it and it runs again. Loading if nothing
+	// is loaded yet (loading starts then, as if the dock had been shown),
+	// Busy if it could not run or finish in time.
+	enum class RemoteResult { Done, Loading, Busy };
+	using RemoteQuery = std::function<bool(const SourceCollection &, const CancelToken &)>;
+	RemoteResult RunRemoteQuery(const RemoteQuery &query);
+
 private slots:
 	void OnSearchTextChanged(const QString &text);
 	void OnSearchScopeChanged(int index);
+	void OnSearchModeChanged(int index);
+	void OnDeepSearchToggled(bool enabled);
+	void OnThumbnailsToggled(bool enabled);
+	void RequestVisibleThumbnails();
 	void OnTypeFilterChanged(int index);
-	void OnResultDoubleClicked(QListWidgetItem *item);
+	void OnResultDoubleClicked(const QModelIndex &index);
 	void OnResultContextMenu(const QPoint &pos);
 	void PerformSearch();
 	void OnSourcesChanged();
+	void LogStats();
 
 private:
 	// Build the UI
 	void SetupUI();
 
+	// Build the index the first time the dock (or a remote query) needs it
+	void LoadOnFirstUse();
+
 	// Update the type filter dropdown
 	void UpdateTypeFilter();
 
 	// Update search results
 	void UpdateResults();
 
+	// Run the search on the search worker; only the newest one is shown
+	void StartSearch(std::string searchText, std::string typeFilter, SearchScope scope, SearchMode mode);
+	void OnSearchFinished(uint64_t ticket, std::shared_ptr<SourceCollection> collection, uint64_t generation,
+			      std::vector<SourceItem *> results, uint64_t searchNs);
+
+	// Debounce from the measured search cost
+	int DebounceInterval() const;
+
+	// Exclusive access for changing the current collection (UI thread);
+	// a search in flight is cancelled and run again afterwards
+	std::unique_lock<std::shared_mutex> LockForChange();
+
+	// "Other collections" scope: search the cached inactive collection files
+	void UpdateOtherResults(const SearchQuery &query, const std::string &typeFilter, SearchMode mode);
+	void RequestCollectionScan();
+	void OnCollectionsScanned(CollectionCache::Files files, CollectionCache::ScanStats stats);
+
+	// Timing stats (p50/p99 per stage)
+	void RecordRefreshTimings(const SourceCollection &collection);
+	void UpdateStatsLabel();
+
 	// Open source properties
 	void OpenSourceProperties(SourceItem *item);
 
@@ -68,6 +125,62 @@ private:
 	static void OnSourceDestroy(void *data, calldata_t *params);
 	static void OnSourceRename(void *data, calldata_t *params);
 
+	// Per-source signal handlers (scene items on scenes and groups, filters
+	// on everything else); data is the dock, the source comes from calldata
+	static void OnSceneItemAdd(void *data, calldata_t *params);
+	static void OnSceneItemRemove(void *data, calldata_t *params);
+	static void OnFilterAdd(void *data, calldata_t *params);
+	static void OnFilterRemove(void *data, calldata_t *params);
+	static void OnSourceUpdate(void *data, calldata_t *params);
+	static void OnSourceState(void *data, calldata_t *params);
+	void SetSourceSignals(obs_source_t *source, bool connect);
+	void PostSceneItemDelta(calldata_t *params);
+
+	// A single source change, applied on the UI thread (and replayed onto
+	// a collection that was being rebuilt in the background). Plain data,
+	// so signal threads can hand it over through the change ring.
+	struct SourceDelta {
+		enum class Kind : uint8_t { Create, Destroy, Rename, SceneList, SceneItem, Settings, State };
+		Kind kind = Kind::Create;
+		obs_weak_source_t *weakSource = nullptr;  // Create/Rename/Settings/State, scene for SceneItem (owned)
+		obs_weak_source_t *weakItem = nullptr;    // SceneItem: the item's source (owned)
+		uint64_t uuidHash = 0;                    // Coalescing key (the scene for SceneItem)
+		uint64_t itemHash = 0;                    // SceneItem: the item's source
+		char uuid[40] = {};                       // Destroy lookup
+	};
+
+	static SourceDelta MakeDelta(SourceDelta::Kind kind, obs_source_t *source, bool keepRef);
+	static uint64_t HashUUID(const char *uuid);
+
+	// Any thread: push to the ring and schedule a drain if none is pending
+	void PostDelta(const SourceDelta &delta);
+
+	// UI thread: take everything queued, drop repeats, apply the rest
+	void DrainDeltas();
+
+	void QueueDelta(SourceDelta delta);
+	static bool ApplyDelta(SourceCollection &collection, const SourceDelta &delta);
+	static void ReleaseDelta(SourceDelta &delta);
+	void ClearPendingDeltas();
+
+	// Live state changes repaint their rows once per frame
+	void RepaintChangedRows();
+
+	// Rebuild the collection on a worker thread and swap it in when done
+	void RequestRefresh();
+	void OnRefreshBuilt(uint64_t generation, std::shared_ptr<SourceCollection> built);
+
+	// Per scene collection index snapshot in the module config dir (UI thread)
+	static QString SnapshotPath();
+
+	// Fill an empty collection from the snapshot while the live build runs
+	bool LoadSnapshot(const QString &path);
+
+	// Deep search: extract every item's settings on a worker, then match them
+	void StartSettingsIndex();
+	void OnSettingsExtracted(std::weak_ptr<SourceCollection> target,
+				 std::vector<SourceCollection::SettingsText> texts, uint64_t extractNs);
+
 	// Connect/disconnect signal handlers
 	void ConnectSignals();
 	void DisconnectSignals();
@@ -76,30 +189,103 @@ private:
 	QVBoxLayout *mainLayout;
 	QLineEdit *searchBox;
 	QComboBox *searchScope;
+	QComboBox *searchMode;
 	QComboBox *typeFilter;
-	QListWidget *resultsList;
+	QCheckBox *deepSearch;
+	QCheckBox *showThumbnails;
+	QListView *resultsView;
+	SourceResultsModel *resultsModel;
 	QLabel *statusLabel;
+	QLabel *statsLabel;
+	QAction *showStatsAction;
+
+	// Source collection (replaced wholesale by background refreshes)
+	std::shared_ptr<SourceCollection> sourceCollection;
 
-	// Source collection
-	std::unique_ptr<SourceCollection> sourceCollection;
+	// Type set the dropdown reflects
+	std::weak_ptr<SourceCollection> typesShownFor;
+	uint64_t typesShownVersion;
 
 	// Current search parameters
 	QString currentSearchText;
 	QString currentSearchScope;
+	QString currentSearchMode;
 	QString currentTypeFilter;
 
-	// Debounce timer for search
+	// Debounce timer for search (interval adapted per keystroke)
 	QTimer *searchTimer;
+	static constexpr int kMinDebounceMs = 10;
+	static constexpr int kMaxDebounceMs = 150;
+	static constexpr uint64_t kTypingIdleNs = 400000000;  // A keystroke after this long runs at once
+	uint64_t lastKeystroke;
+
+	// Searches run one at a time on their own worker under a shared lock;
+	// a newer ticket cancels the one in flight
+	QThreadPool *searchPool;
+	std::atomic<uint64_t> searchTicket;
+
+	// Remote queries: bumped with every change, waited for at most this long
+	static constexpr int kRemoteQueryTimeoutMs = 2000;
+	static constexpr int kRemoteQueryAttempts = 3;
+	std::atomic<uint64_t> remoteTicket;
+	bool searchInFlight;
+	std::shared_mutex collectionMutex;
+
+	// Parallel scan helpers shared by every index
+	std::unique_ptr<ScanPool> scanPool;
 
 	// Debounce timer for source changes (avoid refresh spam during startup)
 	QTimer *refreshTimer;
 
+	// Items whose live state changed since the last repaint (compared,
+	// never dereferenced: they may be gone by then)
+	static constexpr int kFrameMs = 16;
+	QTimer *repaintTimer;
+	std::unordered_set<const SourceItem *> repaintItems;
+
+	// Result previews: the rows on screen are re-requested while shown
+	ThumbnailCache *thumbnails;
+	QTimer *thumbnailTimer;
+	std::unordered_set<std::string> repaintThumbnails;
+
+	// Latency samples and the periodic log summary
+	LatencyStats latencyStats;
+	QTimer *statsTimer;
+	uint64_t statsLogged;
+
+	// Rebuild the whole collection on the next refresh tick (collection change)
+	bool fullRefreshPending;
+
+	// Background refresh state; builds from an older generation are dropped
+	QThreadPool *refreshPool;
+	uint64_t refreshGeneration;
+	bool refreshInFlight;
+	std::vector<SourceDelta> pendingDeltas;  // Replayed onto the new build
+
+	// Signal threads -> UI thread; an overflow falls back to a full refresh
+	static constexpr size_t kChangeRingCapacity = 4096;
+	MpscRing<SourceDelta> changeRing;
+	std::atomic<bool> drainScheduled;
+	std::atomic<bool> ringOverflowed;
+
 	// Signal connection state
 	bool signalsConnected;
 
 	// Lazy initialization - only load sources when dock is first shown
-	bool initialized;
+	// (read from libobs signal threads)
+	std::atomic<bool> initialized;
+
+	// Deep search enabled (read from libobs signal threads); the
+	// collection an extraction is running for
+	std::atomic<bool> deepSearchEnabled;
+	std::weak_ptr<SourceCollection> settingsJobFor;
+
+	// Inactive scene collections, re-read only where a file changed
+	CollectionCache::Files otherCollections;
+	bool collectionScanInFlight;
+	bool collectionScanQueued;
 
 protected:
 	void showEvent(QShowEvent *event) override;
+	void hideEvent(QHideEvent *event) override;
 };
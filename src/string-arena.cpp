@@ -0,0 +1,49 @@
+/*
+ * OBS Source Search Plugin
+ * Copyright (C) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ */
+
+#include "string-arena.hpp"
+
+#include <cstring>
+
+std::string_view StringArena::Store(std::string_view text)
+{
+	if (text.empty())
+		return std::string_view();
+
+	// Oversized strings get a block of their own so the current block
+	// keeps its free space
+	if (text.size() > kBlockSize / 4) {
+		auto block = std::make_unique<char[]>(text.size());
+		memcpy(block.get(), text.data(), text.size());
+		std::string_view stored(block.get(), text.size());
+		reserved += text.size();
+		// Insert below the current block so it stays last
+		blocks.insert(blocks.empty() ? blocks.end() : blocks.end() - 1, std::move(block));
+		return stored;
+	}
+
+	if (blockUsed + text.size() > kBlockSize) {
+		blocks.push_back(std::make_unique<char[]>(kBlockSize));
+		blockUsed = 0;
+		reserved += kBlockSize;
+	}
+
+	char *dest = blocks.back().get() + blockUsed;
+	memcpy(dest, text.data(), text.size());
+	blockUsed += text.size();
+	return std::string_view(dest, text.size());
+}
+
+void StringArena::Clear()
+{
+	blocks.clear();
+	blockUsed = kBlockSize;
+	reserved = 0;
+}
@@ -0,0 +1,36 @@
+/*
+ * OBS Source Search Plugin
+ * Copyright (C) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+// Bump allocator for strings that live as long as one collection build.
+// Stored views stay valid until Clear(), which frees every block at once.
+class StringArena {
+public:
+	// Copy text into the arena
+	std::string_view Store(std::string_view text);
+
+	void Clear();
+
+	// Bytes held in blocks
+	size_t MemoryUsage() const { return reserved; }
+
+private:
+	static constexpr size_t kBlockSize = 16 * 1024;
+
+	std::vector<std::unique_ptr<char[]>> blocks;
+	size_t blockUsed = kBlockSize;  // Forces a block on first Store()
+	size_t reserved = 0;
+};
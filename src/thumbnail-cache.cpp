@@ -0,0 +1,241 @@
+/*
+ * OBS Source Search Plugin
+ * Copyright (C) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ */
+
+#include "thumbnail-cache.hpp"
+#include "latency-stats.hpp"
+
+#include <graphics/vec4.h>
+
+#include <QMetaObject>
+
+#include <algorithm>
+#include <cstring>
+
+ThumbnailCache::ThumbnailCache(QObject *parent) : QObject(parent), placeholder(kWidth, kHeight)
+{
+	placeholder.fill(Qt::transparent);
+}
+
+ThumbnailCache::~ThumbnailCache()
+{
+	enabled = false;
+	UpdateCallback();
+
+	// Removing the callback waits for a frame in progress, so the render
+	// thread is done with the texture and the wanted list by now
+	DestroyGraphics();
+
+	for (auto &item : wanted) {
+		obs_weak_source_release(item.weakSource);
+	}
+}
+
+void ThumbnailCache::SetEnabled(bool enable)
+{
+	enabled = enable;
+	UpdateCallback();
+}
+
+void ThumbnailCache::SetPaused(bool pause)
+{
+	paused = pause;
+	UpdateCallback();
+}
+
+void ThumbnailCache::UpdateCallback()
+{
+	bool run = IsRunning();
+	if (run == callbackInstalled)
+		return;
+
+	if (run)
+		obs_add_main_render_callback(RenderCallback, this);
+	else
+		obs_remove_main_render_callback(RenderCallback, this);
+	callbackInstalled = run;
+}
+
+void ThumbnailCache::Request(const std::vector<obs_source_t *> &sources)
+{
+	uint64_t now = LatencyNow();
+
+	std::vector<Wanted> next;
+	for (obs_source_t *source : sources) {
+		// Audio-only sources have nothing to show
+		if (!(obs_source_get_output_flags(source) & OBS_SOURCE_VIDEO))
+			continue;
+
+		const char *uuid = obs_source_get_uuid(source);
+		if (!uuid)
+			continue;
+
+		auto it = entries.find(uuid);
+		if (it != entries.end() && now - it->second.renderedAt < kMaxAgeNs)
+			continue;
+
+		next.push_back({uuid, obs_source_get_weak_source(source)});
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(wantedMutex);
+		wanted.swap(next);
+	}
+
+	// What was still queued is no longer on screen
+	for (auto &item : next) {
+		obs_weak_source_release(item.weakSource);
+	}
+}
+
+const QPixmap *ThumbnailCache::Find(const std::string &uuid)
+{
+	auto it = entries.find(uuid);
+	if (it == entries.end())
+		return nullptr;
+
+	recency.splice(recency.begin(), recency, it->second.position);
+	return &it->second.pixmap;
+}
+
+void ThumbnailCache::Store(const std::string &uuid, const QImage &image)
+{
+	auto it = entries.find(uuid);
+	if (it != entries.end()) {
+		it->second.pixmap = QPixmap::fromImage(image);
+		it->second.renderedAt = LatencyNow();
+		recency.splice(recency.begin(), recency, it->second.position);
+	} else {
+		recency.push_front(uuid);
+		entries.emplace(uuid, Entry{QPixmap::fromImage(image), LatencyNow(), recency.begin()});
+
+		while (entries.size() > kCapacity) {
+			entries.erase(recency.back());
+			recency.pop_back();
+		}
+	}
+
+	emit ThumbnailReady(uuid);
+}
+
+void ThumbnailCache::RenderCallback(void *param, uint32_t cx, uint32_t cy)
+{
+	UNUSED_PARAMETER(cx);
+	UNUSED_PARAMETER(cy);
+	static_cast<ThumbnailCache *>(param)->RenderFrame();
+}
+
+void ThumbnailCache::RenderFrame()
+{
+	if (!texrender) {
+		texrender = gs_texrender_create(GS_RGBA, GS_ZS_NONE);
+		for (auto &stage : stages) {
+			stage = gs_stagesurface_create(kWidth, kHeight, GS_RGBA);
+		}
+	}
+
+	// Last frame's copies have landed by now
+	ReadBack();
+
+	// The rest of the budget: at most kPerFrame new draws
+	for (size_t slot = 0; slot < kPerFrame; slot++) {
+		Wanted next;
+		{
+			std::lock_guard<std::mutex> lock(wantedMutex);
+			if (wanted.empty())
+				return;
+			next = std::move(wanted.front());
+			wanted.erase(wanted.begin());
+		}
+
+		obs_source_t *source = obs_weak_source_get_source(next.weakSource);
+		obs_weak_source_release(next.weakSource);
+		if (!source)
+			continue;
+
+		if (Draw(source)) {
+			gs_stage_texture(stages[slot], gs_texrender_get_texture(texrender));
+			staged[slot] = std::move(next.uuid);
+		}
+		obs_source_release(source);
+	}
+}
+
+bool ThumbnailCache::Draw(obs_source_t *source)
+{
+	uint32_t width = obs_source_get_width(source);
+	uint32_t height = obs_source_get_height(source);
+	if (!width || !height)
+		return false;
+
+	gs_texrender_reset(texrender);
+	if (!gs_texrender_begin(texrender, kWidth, kHeight))
+		return false;
+
+	struct vec4 clear;
+	vec4_zero(&clear);
+	gs_clear(GS_CLEAR_COLOR, &clear, 0.0f, 0);
+
+	// Letterbox: widen the projection to the preview's aspect ratio
+	float sourceWidth = static_cast<float>(width);
+	float sourceHeight = static_cast<float>(height);
+	float aspect = static_cast<float>(kWidth) / static_cast<float>(kHeight);
+	float padX = std::max(0.0f, (sourceHeight * aspect - sourceWidth) / 2.0f);
+	float padY = std::max(0.0f, (sourceWidth / aspect - sourceHeight) / 2.0f);
+	gs_ortho(-padX, sourceWidth + padX, -padY, sourceHeight + padY, -100.0f, 100.0f);
+
+	gs_blend_state_push();
+	gs_blend_function(GS_BLEND_ONE, GS_BLEND_ZERO);
+	obs_source_video_render(source);
+	gs_blend_state_pop();
+
+	gs_texrender_end(texrender);
+	return true;
+}
+
+void ThumbnailCache::ReadBack()
+{
+	for (size_t slot = 0; slot < kPerFrame; slot++) {
+		if (staged[slot].empty())
+			continue;
+
+		std::string uuid = std::move(staged[slot]);
+		staged[slot].clear();
+
+		uint8_t *data = nullptr;
+		uint32_t linesize = 0;
+		if (!gs_stagesurface_map(stages[slot], &data, &linesize))
+			continue;
+
+		QImage image(kWidth, kHeight, QImage::Format_RGBA8888);
+		for (int y = 0; y < kHeight; y++) {
+			memcpy(image.scanLine(y), data + static_cast<size_t>(y) * linesize, kWidth * 4);
+		}
+		gs_stagesurface_unmap(stages[slot]);
+
+		// Pixmaps are made and the LRU is touched on the UI thread only
+		QMetaObject::invokeMethod(
+			this, [this, uuid, image]() { Store(uuid, image); }, Qt::QueuedConnection);
+	}
+}
+
+void ThumbnailCache::DestroyGraphics()
+{
+	if (!texrender)
+		return;
+
+	obs_enter_graphics();
+	gs_texrender_destroy(texrender);
+	for (auto &stage : stages) {
+		gs_stagesurface_destroy(stage);
+		stage = nullptr;
+	}
+	obs_leave_graphics();
+	texrender = nullptr;
+}
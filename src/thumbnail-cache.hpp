@@ -0,0 +1,102 @@
+/*
+ * OBS Source Search Plugin
+ * Copyright (C) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ */
+
+#pragma once
+
+#include <obs.h>
+
+#include <QImage>
+#include <QObject>
+#include <QPixmap>
+
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Small previews of sources for the result list. The UI thread names the
+// sources it shows; the render thread draws at most kPerFrame of them per
+// frame into one shared offscreen texture and reads each back a frame
+// later, so it never waits on the GPU. Images are kept in an LRU by UUID.
+class ThumbnailCache : public QObject {
+	Q_OBJECT
+
+public:
+	static constexpr int kWidth = 64;
+	static constexpr int kHeight = 36;
+	static constexpr size_t kPerFrame = 2;
+	static constexpr size_t kCapacity = 256;
+	static constexpr uint64_t kMaxAgeNs = 2000000000;  // Shown previews are redrawn after this
+
+	explicit ThumbnailCache(QObject *parent = nullptr);
+	~ThumbnailCache();
+
+	// The render callback is only installed while enabled and not paused
+	// (dock hidden), so nothing runs on the render thread otherwise
+	void SetEnabled(bool enabled);
+	void SetPaused(bool paused);
+	bool IsRunning() const { return enabled && !paused; }
+
+	// Replace what the render thread should draw: sources on screen, in
+	// row order. Fresh ones are skipped. UI thread.
+	void Request(const std::vector<obs_source_t *> &sources);
+
+	// Preview of a source (nullptr if none yet), marking it recently used
+	const QPixmap *Find(const std::string &uuid);
+
+	// Same size as a preview, for rows that don't have one (yet)
+	const QPixmap &Placeholder() const { return placeholder; }
+
+signals:
+	// A preview was stored or redrawn (UI thread)
+	void ThumbnailReady(const std::string &uuid);
+
+private:
+	struct Wanted {
+		std::string uuid;
+		obs_weak_source_t *weakSource = nullptr;  // Owned
+	};
+
+	// Render thread
+	static void RenderCallback(void *param, uint32_t cx, uint32_t cy);
+	void RenderFrame();
+	void ReadBack();
+	bool Draw(obs_source_t *source);
+	void DestroyGraphics();
+
+	// UI thread
+	void Store(const std::string &uuid, const QImage &image);
+	void UpdateCallback();
+
+	bool enabled = false;
+	bool paused = false;
+	bool callbackInstalled = false;
+
+	// UI thread -> render thread
+	std::mutex wantedMutex;
+	std::vector<Wanted> wanted;
+
+	// Render thread only: one texture, a staging surface per slot
+	gs_texrender_t *texrender = nullptr;
+	gs_stagesurf_t *stages[kPerFrame] = {};
+	std::string staged[kPerFrame];
+
+	// UI thread only: most recently used first
+	struct Entry {
+		QPixmap pixmap;
+		uint64_t renderedAt;
+		std::list<std::string>::iterator position;
+	};
+	std::list<std::string> recency;
+	std::unordered_map<std::string, Entry> entries;
+	QPixmap placeholder;
+};
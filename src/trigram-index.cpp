@@ -0,0 +1,133 @@
+/*
+ * OBS Source Search Plugin
+ * Copyright (C) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ */
+
+#include "trigram-index.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+void TrigramIndex::Clear()
+{
+	postings.clear();
+}
+
+void TrigramIndex::CollectTrigrams(const char *text, size_t length, std::vector<uint32_t> &out)
+{
+	out.clear();
+	if (length < 3)
+		return;
+
+	const unsigned char *p = reinterpret_cast<const unsigned char *>(text);
+	for (size_t i = 0; i + 3 <= length; i++) {
+		out.push_back(static_cast<uint32_t>(p[i]) << 16 | static_cast<uint32_t>(p[i + 1]) << 8 |
+			      static_cast<uint32_t>(p[i + 2]));
+	}
+
+	std::sort(out.begin(), out.end());
+	out.erase(std::unique(out.begin(), out.end()), out.end());
+}
+
+void TrigramIndex::Add(Row row, const char *name, size_t length)
+{
+	std::vector<uint32_t> keys;
+	CollectTrigrams(name, length, keys);
+
+	for (uint32_t key : keys) {
+		std::vector<Row> &list = postings[key];
+		// Rows are mostly appended in ascending order
+		if (list.empty() || list.back() < row)
+			list.push_back(row);
+		else
+			list.insert(std::lower_bound(list.begin(), list.end(), row), row);
+	}
+}
+
+void TrigramIndex::Remove(Row row, const char *name, size_t length)
+{
+	std::vector<uint32_t> keys;
+	CollectTrigrams(name, length, keys);
+
+	for (uint32_t key : keys) {
+		auto it = postings.find(key);
+		if (it == postings.end())
+			continue;
+
+		std::vector<Row> &list = it->second;
+		auto pos = std::lower_bound(list.begin(), list.end(), row);
+		if (pos != list.end() && *pos == row)
+			list.erase(pos);
+
+		if (list.empty())
+			postings.erase(it);
+	}
+}
+
+void TrigramIndex::Move(Row from, Row to, const char *name, size_t length)
+{
+	if (from == to)
+		return;
+
+	std::vector<uint32_t> keys;
+	CollectTrigrams(name, length, keys);
+
+	for (uint32_t key : keys) {
+		auto it = postings.find(key);
+		if (it == postings.end())
+			continue;
+
+		std::vector<Row> &list = it->second;
+		auto pos = std::lower_bound(list.begin(), list.end(), from);
+		if (pos != list.end() && *pos == from)
+			list.erase(pos);
+		list.insert(std::lower_bound(list.begin(), list.end(), to), to);
+	}
+}
+
+void TrigramIndex::Candidates(const char *needle, size_t length, std::vector<Row> &out) const
+{
+	out.clear();
+
+	std::vector<uint32_t> keys;
+	CollectTrigrams(needle, length, keys);
+	if (keys.empty())
+		return;
+
+	// Any trigram nobody has means no row can match
+	std::vector<const std::vector<Row> *> lists;
+	lists.reserve(keys.size());
+	for (uint32_t key : keys) {
+		auto it = postings.find(key);
+		if (it == postings.end())
+			return;
+		lists.push_back(&it->second);
+	}
+
+	// Intersect starting from the most selective list
+	std::sort(lists.begin(), lists.end(),
+		  [](const std::vector<Row> *a, const std::vector<Row> *b) { return a->size() < b->size(); });
+
+	out = *lists[0];
+	std::vector<Row> narrowed;
+	for (size_t i = 1; i < lists.size() && !out.empty(); i++) {
+		narrowed.clear();
+		std::set_intersection(out.begin(), out.end(), lists[i]->begin(), lists[i]->end(),
+				      std::back_inserter(narrowed));
+		out.swap(narrowed);
+	}
+}
+
+size_t TrigramIndex::MemoryUsage() const
+{
+	size_t bytes = postings.bucket_count() * sizeof(void *);
+	for (const auto &[key, list] : postings) {
+		bytes += sizeof(key) + sizeof(list) + sizeof(void *) + list.capacity() * sizeof(Row);
+	}
+	return bytes;
+}
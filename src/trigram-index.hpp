@@ -0,0 +1,48 @@
+/*
+ * OBS Source Search Plugin
+ * Copyright (C) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// Inverted index from byte trigrams of folded names to SourceIndex rows.
+// Posting lists are kept sorted so a query is an intersection of the
+// lists for the needle's trigrams; the result is a superset of the real
+// matches and still has to be verified with the substring matcher.
+class TrigramIndex {
+public:
+	using Row = uint32_t;
+
+	// Needles shorter than this can't use the index
+	static constexpr size_t kMinQueryLength = 3;
+
+	void Clear();
+
+	void Add(Row row, const char *name, size_t length);
+	void Remove(Row row, const char *name, size_t length);
+
+	// The row with this name moved from one slot to another (swap removal)
+	void Move(Row from, Row to, const char *name, size_t length);
+
+	// Rows containing every trigram of the needle, ascending
+	void Candidates(const char *needle, size_t length, std::vector<Row> &out) const;
+
+	// Approximate heap footprint in bytes
+	size_t MemoryUsage() const;
+
+private:
+	// Sorted, de-duplicated trigram keys of a string
+	static void CollectTrigrams(const char *text, size_t length, std::vector<uint32_t> &out);
+
+	std::unordered_map<uint32_t, std::vector<Row>> postings;
+};
@@ -0,0 +1,44 @@
+/*
+ * OBS Source Search Plugin
+ * Copyright (C) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ */
+
+#include "type-registry.hpp"
+
+bool TypeRegistry::Add(const std::string &typeId)
+{
+	uint32_t &count = counts[typeId];
+	if (count++ > 0)
+		return false;
+
+	version++;
+	return true;
+}
+
+bool TypeRegistry::Release(const std::string &typeId)
+{
+	auto it = counts.find(typeId);
+	if (it == counts.end())
+		return false;
+
+	if (--it->second > 0)
+		return false;
+
+	counts.erase(it);
+	version++;
+	return true;
+}
+
+void TypeRegistry::Clear()
+{
+	if (counts.empty())
+		return;
+
+	counts.clear();
+	version++;
+}
@@ -0,0 +1,40 @@
+/*
+ * OBS Source Search Plugin
+ * Copyright (C) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+// Reference-counted set of the type IDs present in a collection. The
+// version only moves when a type appears or disappears, so the type
+// dropdown can skip updates while the set stays the same.
+class TypeRegistry {
+public:
+	// True if this is the first item of the type
+	bool Add(const std::string &typeId);
+
+	// True if that was the last item of the type
+	bool Release(const std::string &typeId);
+
+	void Clear();
+
+	bool Contains(const std::string &typeId) const { return counts.count(typeId) != 0; }
+	size_t Size() const { return counts.size(); }
+	uint64_t Version() const { return version; }
+
+	// typeId -> number of items
+	const std::unordered_map<std::string, uint32_t> &Counts() const { return counts; }
+
+private:
+	std::unordered_map<std::string, uint32_t> counts;
+	uint64_t version = 0;
+};
@@ -0,0 +1,312 @@
+/*
+ * OBS Source Search Plugin
+ * Copyright (C) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ */
+
+#include "websocket-vendor.hpp"
+#include "source-search-dock.hpp"
+
+#include <obs.h>
+
+#include <algorithm>
+#include <cstring>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr const char *kVendorName = "obs-source-search";
+constexpr long long kDefaultPageSize = 50;
+constexpr long long kMaxPageSize = 500;
+
+// The parts of obs-websocket's vendor API used here (obs-websocket-api.h
+// is a thin layer over these proc handler calls)
+typedef void (*VendorRequestFunction)(obs_data_t *requestData, obs_data_t *responseData, void *privData);
+struct VendorRequestCallback {
+	VendorRequestFunction callback;
+	void *privData;
+};
+
+// Held shared while a request runs, so the dock is never cleared under one
+std::shared_mutex dockMutex;
+SourceSearchDock *vendorDock = nullptr;
+
+// Set while our requests are registered with obs-websocket
+proc_handler_t *websocketPh = nullptr;
+void *websocketVendor = nullptr;
+
+const char *KindName(const SourceItem *item)
+{
+	switch (item->GetSourceClass()) {
+	case SourceClass::Scene:
+		return "scene";
+	case SourceClass::Group:
+		return "group";
+	case SourceClass::Filter:
+		return "filter";
+	default:
+		return "source";
+	}
+}
+
+obs_data_t *ItemData(const SourceItem *item)
+{
+	obs_data_t *data = obs_data_create();
+	obs_data_set_string(data, "name", item->GetName().c_str());
+	obs_data_set_string(data, "uuid", item->GetUUID().c_str());
+	obs_data_set_string(data, "type", item->GetTypeId().c_str());
+	return data;
+}
+
+// Scene names behind name IDs, sorted like the results list shows them
+void SetSceneNames(obs_data_t *response, const char *key, const SourceCollection &collection,
+		   const std::vector<uint32_t> &sceneIds)
+{
+	std::vector<std::string> names;
+	names.reserve(sceneIds.size());
+	for (uint32_t sceneId : sceneIds) {
+		names.emplace_back(collection.GetInternedName(sceneId));
+	}
+	std::sort(names.begin(), names.end());
+
+	obs_data_array_t *array = obs_data_array_create();
+	for (const auto &name : names) {
+		obs_data_t *entry = obs_data_create();
+		obs_data_set_string(entry, "name", name.c_str());
+		obs_data_array_push_back(array, entry);
+		obs_data_release(entry);
+	}
+	obs_data_set_array(response, key, array);
+	obs_data_array_release(array);
+}
+
+// Run a query on the dock's collection; false (with "error" set) if
+// there is no dock, nothing is loaded yet or the dock stayed busy
+bool RunQuery(obs_data_t *response, const SourceSearchDock::RemoteQuery &query)
+{
+	std::shared_lock<std::shared_mutex> lock(dockMutex);
+	if (!vendorDock) {
+		obs_data_set_string(response, "error", "Source Search is not available");
+		return false;
+	}
+
+	switch (vendorDock->RunRemoteQuery(query)) {
+	case SourceSearchDock::RemoteResult::Done:
+		return true;
+	case SourceSearchDock::RemoteResult::Loading:
+		obs_data_set_string(response, "error", "Sources are still loading, try again shortly");
+		return false;
+	default:
+		obs_data_set_string(response, "error", "Source Search is busy, try again shortly");
+		return false;
+	}
+}
+
+// The item a request names by "uuid", or nullptr with "error" set
+const SourceItem *RequestedItem(const SourceCollection &collection, obs_data_t *request, obs_data_t *response)
+{
+	const char *uuid = obs_data_get_string(request, "uuid");
+	SourceItem *item = uuid && *uuid ? collection.FindByUUID(uuid) : nullptr;
+	if (!item)
+		obs_data_set_string(response, "error", "No source with that UUID");
+	return item;
+}
+
+void OnSearchRequest(obs_data_t *request, obs_data_t *response, void *data)
+{
+	UNUSED_PARAMETER(data);
+
+	std::string text = obs_data_get_string(request, "query");
+	std::string typeFilter = obs_data_get_string(request, "type");
+
+	const char *scopeName = obs_data_get_string(request, "scope");
+	SearchScope scope = SearchScope::All;
+	if (strcmp(scopeName, "sources") == 0)
+		scope = SearchScope::Sources;
+	else if (strcmp(scopeName, "filters") == 0)
+		scope = SearchScope::Filters;
+
+	SearchMode mode = strcmp(obs_data_get_string(request, "mode"), "fuzzy") == 0 ? SearchMode::Fuzzy
+										    : SearchMode::Contains;
+
+	long long offset = std::max(0LL, obs_data_get_int(request, "offset"));
+	long long limit = kDefaultPageSize;
+	if (obs_data_has_user_value(request, "limit"))
+		limit = std::clamp(obs_data_get_int(request, "limit"), 0LL, kMaxPageSize);
+
+	RunQuery(response, [&](const SourceCollection &collection, const CancelToken &cancel) {
+		std::vector<SourceItem *> results = collection.Search(text, typeFilter, scope, mode, cancel);
+		if (cancel.Cancelled())
+			return false;
+
+		size_t total = results.size();
+		size_t first = std::min(total, static_cast<size_t>(offset));
+		size_t last = std::min(total, first + static_cast<size_t>(limit));
+
+		obs_data_array_t *array = obs_data_array_create();
+		for (size_t i = first; i < last; i++) {
+			obs_data_t *entry = ItemData(results[i]);
+			obs_data_set_string(entry, "kind", KindName(results[i]));
+			obs_data_array_push_back(array, entry);
+			obs_data_release(entry);
+		}
+
+		obs_data_set_int(response, "total", static_cast<long long>(total));
+		obs_data_set_int(response, "offset", static_cast<long long>(first));
+		obs_data_set_array(response, "results", array);
+		obs_data_array_release(array);
+		return true;
+	});
+}
+
+void OnGetParentsRequest(obs_data_t *request, obs_data_t *response, void *data)
+{
+	UNUSED_PARAMETER(data);
+
+	// Lookups only: never cancelled
+	RunQuery(response, [&](const SourceCollection &collection, const CancelToken &) {
+		const SourceItem *item = RequestedItem(collection, request, response);
+		if (!item)
+			return true;
+
+		// A filter's parent is the source it is on
+		if (item->IsFilter()) {
+			std::string source(collection.GetInternedName(item->GetParentSourceId()));
+			obs_data_set_string(response, "source", source.c_str());
+			SetSceneNames(response, "scenes", collection, {});
+			SetSceneNames(response, "nested", collection, {});
+			return true;
+		}
+
+		std::vector<uint32_t> nested;
+		collection.CollectNestedScenes(item, nested);
+		SetSceneNames(response, "scenes", collection, item->GetParentScenes());
+		SetSceneNames(response, "nested", collection, nested);
+		return true;
+	});
+}
+
+void OnGetFiltersRequest(obs_data_t *request, obs_data_t *response, void *data)
+{
+	UNUSED_PARAMETER(data);
+
+	RunQuery(response, [&](const SourceCollection &collection, const CancelToken &) {
+		const SourceItem *item = RequestedItem(collection, request, response);
+		if (!item)
+			return true;
+
+		obs_data_array_t *array = obs_data_array_create();
+		if (!item->IsFilter()) {
+			for (const SourceItem *filter : collection.GetFilters(item)) {
+				obs_data_t *entry = ItemData(filter);
+				obs_data_array_push_back(array, entry);
+				obs_data_release(entry);
+			}
+		}
+		obs_data_set_array(response, "filters", array);
+		obs_data_array_release(array);
+		return true;
+	});
+}
+
+struct VendorRequest {
+	const char *type;
+	VendorRequestFunction function;
+};
+
+const VendorRequest kRequests[] = {
+	{"Search", OnSearchRequest},
+	{"GetParents", OnGetParentsRequest},
+	{"GetFilters", OnGetFiltersRequest},
+};
+
+proc_handler_t *WebsocketProcHandler()
+{
+	calldata_t cd;
+	calldata_init(&cd);
+	proc_handler_t *ph = nullptr;
+	if (proc_handler_call(obs_get_proc_handler(), "obs_websocket_api_get_ph", &cd))
+		ph = static_cast<proc_handler_t *>(calldata_ptr(&cd, "ph"));
+	calldata_free(&cd);
+	return ph;
+}
+
+bool RegisterRequest(proc_handler_t *ph, void *vendor, const char *type, VendorRequestFunction function)
+{
+	VendorRequestCallback callback = {function, nullptr};
+
+	calldata_t cd;
+	calldata_init(&cd);
+	calldata_set_ptr(&cd, "vendor", vendor);
+	calldata_set_string(&cd, "type", type);
+	calldata_set_ptr(&cd, "callback", &callback);
+	bool registered = proc_handler_call(ph, "vendor_request_register", &cd) && calldata_bool(&cd, "success");
+	calldata_free(&cd);
+
+	if (!registered)
+		blog(LOG_WARNING, "[Source Search] Could not register websocket request %s", type);
+	return registered;
+}
+
+} // namespace
+
+void RegisterWebsocketVendor()
+{
+	proc_handler_t *ph = WebsocketProcHandler();
+	if (!ph) {
+		blog(LOG_INFO, "[Source Search] obs-websocket not found, remote requests disabled");
+		return;
+	}
+
+	calldata_t cd;
+	calldata_init(&cd);
+	calldata_set_string(&cd, "name", kVendorName);
+	void *vendor = nullptr;
+	if (proc_handler_call(ph, "vendor_register", &cd))
+		vendor = calldata_ptr(&cd, "vendor");
+	calldata_free(&cd);
+
+	if (!vendor) {
+		blog(LOG_WARNING, "[Source Search] Could not register obs-websocket vendor %s", kVendorName);
+		return;
+	}
+
+	for (const auto &request : kRequests) {
+		RegisterRequest(ph, vendor, request.type, request.function);
+	}
+	websocketPh = ph;
+	websocketVendor = vendor;
+	blog(LOG_INFO, "[Source Search] Registered obs-websocket vendor %s", kVendorName);
+}
+
+void UnregisterWebsocketVendor()
+{
+	SetWebsocketVendorDock(nullptr);
+
+	if (!websocketVendor)
+		return;
+
+	for (const auto &request : kRequests) {
+		calldata_t cd;
+		calldata_init(&cd);
+		calldata_set_ptr(&cd, "vendor", websocketVendor);
+		calldata_set_string(&cd, "type", request.type);
+		proc_handler_call(websocketPh, "vendor_request_unregister", &cd);
+		calldata_free(&cd);
+	}
+	websocketPh = nullptr;
+	websocketVendor = nullptr;
+}
+
+void SetWebsocketVendorDock(SourceSearchDock *dock)
+{
+	// Waits for requests in progress to finish
+	std::unique_lock<std::shared_mutex> lock(dockMutex);
+	vendorDock = dock;
+}
@@ -0,0 +1,35 @@
+/*
+ * OBS Source Search Plugin
+ * Copyright (C) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ */
+
+#pragma once
+
+class SourceSearchDock;
+
+// obs-websocket vendor "obs-source-search". Remote clients send
+// CallVendorRequest with one of these request types:
+//
+//   Search      {query, type?, scope? (all|sources|filters),
+//                mode? (contains|fuzzy), offset?, limit?}
+//            -> {total, offset, results: [{name, uuid, type, kind}]}
+//   GetParents  {uuid} -> {scenes: [{name}], nested: [{name}], source?}
+//   GetFilters  {uuid} -> {filters: [{name, uuid, type}]}
+//
+// Every request is answered from the dock's index, without enumerating
+// scenes. Failures set "error" in the response. Lists are arrays of
+// objects, since obs_data arrays can't hold bare strings.
+//
+// Registration does nothing if obs-websocket is not installed. Requests
+// are answered only while a dock is set; clear it before the dock goes away.
+void RegisterWebsocketVendor();
+void SetWebsocketVendorDock(SourceSearchDock *dock);
+
+// Clear the dock and remove our requests from obs-websocket (while it is
+// still loaded: frontend shutdown, before the dock is destroyed)
+void UnregisterWebsocketVendor();